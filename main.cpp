@@ -1,9 +1,242 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QGuiApplication>
 
 #include "src/include/mainwindow.hpp"
+#include "src/include/controller/OffscreenExporter.hpp"
+#include "src/include/model/Checkpoint.hpp"
+#include "src/include/model/EnsembleRunner.hpp"
+#include "src/include/model/Network.hpp"
+#include "src/include/model/Simulation.hpp"
+#include "src/include/view/SnapshotExporter.hpp"
+
+namespace
+{
+
+constexpr auto EXPORTARGUMENT = "--export";
+constexpr auto ENSEMBLEARGUMENT = "--ensemble";
+constexpr auto DEFAULTEXPORTWIDTH = uint32_t{1300};
+constexpr auto DEFAULTEXPORTHEIGHT = uint32_t{820};
+
+/* renders trajectory file to images without window, usable on machines without display */
+int exportTrajectory(int argc, char *argv[])
+{
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    auto application = QGuiApplication{argc, argv};
+
+    auto parser = QCommandLineParser{};
+    parser.setApplicationDescription("Renders recorded trajectory to PNG sequence or raw video");
+    parser.addHelpOption();
+    parser.addOption({"export", "Export trajectory instead of opening window."});
+    parser.addOption({"raw", "Write raw RGB24 video stream instead of PNG sequence."});
+    parser.addOption({"width", "Width of exported images.", "pixels",
+        QString::number(DEFAULTEXPORTWIDTH)});
+    parser.addOption({"height", "Height of exported images.", "pixels",
+        QString::number(DEFAULTEXPORTHEIGHT)});
+    parser.addOption({"interval", "Export every n-th frame of trajectory.", "n", "1"});
+    parser.addPositionalArgument("trajectory", "Trajectory file to export.");
+    parser.addPositionalArgument("output", "Directory of PNG sequence or file of raw video.");
+    parser.process(application);
+
+    const auto arguments = parser.positionalArguments();
+    if(std::size(arguments) != 2)
+    {
+        parser.showHelp(1);
+    }
+
+    const auto settings = trafficsimulation::controller::ExportSettings{
+        parser.isSet("raw") ? trafficsimulation::view::ExportFormat::RawVideo
+            : trafficsimulation::view::ExportFormat::PngSequence,
+        parser.value("width").toUInt(), parser.value("height").toUInt(),
+        parser.value("interval").toULongLong()};
+    const auto result = trafficsimulation::controller::OffscreenExporter{settings}
+        .exportTrajectory(arguments[0].toStdString(), arguments[1].toStdString());
+    if(result.has_value())
+    {
+        std::cerr << result.value() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/* network of ensemble is created from junctions and paths of checkpoint without painters */
+std::optional<std::string> createNetwork(const trafficsimulation::model::Checkpoint& checkpoint,
+    const std::string& filePath, trafficsimulation::model::Network& network)
+{
+    auto simulation = trafficsimulation::model::Simulation{checkpoint.seed};
+    /* first junction is created by simulation itself */
+    for(auto iterator = std::size_t{1}; iterator < std::size(checkpoint.junctions); ++iterator)
+    {
+        simulation.addJunction(checkpoint.junctions[iterator].position, nullptr);
+    }
+    const auto junctions = simulation.getJunctions();
+    const auto findJunction = [&junctions](const uint32_t junctionId)
+        {
+            return std::find_if(junctions.cbegin(), junctions.cend(),
+                [junctionId](const auto j){ return j->getId() == junctionId; });
+        };
+
+    for(const auto& path : checkpoint.paths)
+    {
+        const auto startJunction = findJunction(path.startJunctionId);
+        const auto endJunction = findJunction(path.endJunctionId);
+        if(startJunction == junctions.cend() || endJunction == junctions.cend())
+        {
+            return "Checkpoint " + filePath + " is corrupted";
+        }
+        if(path.pathType == trafficsimulation::model::PathType::Road)
+        {
+            simulation.addRoad(*startJunction, *endJunction, path.length, path.roadCondition,
+                path.speedLimit, path.laneCount, nullptr);
+            continue;
+        }
+        simulation.addPavement(*startJunction, *endJunction, path.length, nullptr);
+    }
+    return simulation.createNetwork(network);
+}
+
+/* runs simulations of checkpoint with consecutive seeds on all cores and prints statistics,
+ * drivers and pedestrians of checkpoint are spawned again at start of each simulation.
+ * Snapshots of each simulation are rendered without window into directory named by its seed */
+int runEnsemble(int argc, char *argv[])
+{
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    auto application = QGuiApplication{argc, argv};
+
+    auto parser = QCommandLineParser{};
+    parser.setApplicationDescription("Runs many simulations of checkpoint without window and "
+        "prints statistics of roads aggregated over them");
+    parser.addHelpOption();
+    parser.addOption({"ensemble", "Run ensemble instead of opening window."});
+    parser.addOption({"threads", "Number of worker threads, 0 for all cores.", "n", "0"});
+    parser.addOption({"snapshots", "Write PNG snapshots of each simulation to subdirectory "
+        "of directory named by its seed.", "directory"});
+    parser.addOption({"interval", "Write snapshot every n ticks.", "n", "1"});
+    parser.addOption({"width", "Width of snapshots.", "pixels",
+        QString::number(DEFAULTEXPORTWIDTH)});
+    parser.addOption({"height", "Height of snapshots.", "pixels",
+        QString::number(DEFAULTEXPORTHEIGHT)});
+    parser.addPositionalArgument("checkpoint", "Checkpoint with network, agents and demand.");
+    parser.addPositionalArgument("seeds",
+        "Number of simulations, their seeds follow seed of checkpoint.");
+    parser.addPositionalArgument("ticks", "Number of ticks of each simulation.");
+    parser.process(application);
+
+    const auto arguments = parser.positionalArguments();
+    if(std::size(arguments) != 3)
+    {
+        parser.showHelp(1);
+    }
+    auto seedsValid = false;
+    auto ticksValid = false;
+    auto threadsValid = false;
+    auto intervalValid = false;
+    const auto seeds = arguments[1].toUInt(&seedsValid);
+    const auto ticks = arguments[2].toULongLong(&ticksValid);
+    const auto threads = parser.value("threads").toUInt(&threadsValid);
+    const auto interval = parser.value("interval").toULongLong(&intervalValid);
+    const auto imageSize = QSize(parser.value("width").toInt(), parser.value("height").toInt());
+    if(!seedsValid || !ticksValid || !threadsValid || !intervalValid || seeds == 0
+        || interval == 0 || imageSize.isEmpty())
+    {
+        parser.showHelp(1);
+    }
+
+    const auto filePath = arguments[0].toStdString();
+    auto checkpoint = trafficsimulation::model::Checkpoint{};
+    auto result = trafficsimulation::model::readCheckpoint(filePath, checkpoint);
+    auto network = std::make_shared<trafficsimulation::model::Network>();
+    if(!result.has_value())
+    {
+        result = createNetwork(checkpoint, filePath, *network);
+    }
+    if(result.has_value())
+    {
+        std::cerr << result.value() << std::endl;
+        return 1;
+    }
+
+    auto members = std::vector<trafficsimulation::model::EnsembleMember>{};
+    auto snapshotExporters
+        = std::vector<std::shared_ptr<trafficsimulation::view::SnapshotExporter>>{};
+    for(auto iterator = uint32_t{0}; iterator < seeds; ++iterator)
+    {
+        const auto seed = checkpoint.seed + iterator;
+        members.push_back({seed, static_cast<uint32_t>(std::size(checkpoint.drivers)),
+            static_cast<uint32_t>(std::size(checkpoint.pedestrians)),
+            checkpoint.demand.driverDistribution, checkpoint.demand, nullptr, {}});
+        if(parser.isSet("snapshots"))
+        {
+            snapshotExporters.push_back(std::make_shared<trafficsimulation::view::SnapshotExporter>(
+                imageSize, trafficsimulation::view::ExportFormat::PngSequence,
+                parser.value("snapshots").toStdString() + "/" + std::to_string(seed)));
+            members.back().snapshotPainter = snapshotExporters.back();
+            members.back().snapshotInterval = interval;
+        }
+    }
+    const auto statistics = trafficsimulation::model::EnsembleRunner{network}
+        .run(members, ticks, threads);
+
+    auto snapshotsWritten = true;
+    for(auto iterator = std::size_t{0}; iterator < std::size(snapshotExporters); ++iterator)
+    {
+        const auto snapshotResult = snapshotExporters[iterator]->close();
+        if(snapshotResult.has_value())
+        {
+            std::cerr << "snapshots of seed " << members[iterator].seed << ": "
+                << snapshotResult.value() << std::endl;
+            snapshotsWritten = false;
+        }
+    }
+    auto succeeded = uint32_t{0};
+    for(const auto& member : statistics.results)
+    {
+        if(member.error.has_value())
+        {
+            std::cerr << "seed " << member.seed << ": " << member.error.value() << std::endl;
+            continue;
+        }
+        succeeded++;
+    }
+    if(succeeded == 0)
+    {
+        return 1;
+    }
+    std::cout << "simulations " << succeeded << "/" << seeds << std::endl;
+    std::cout << "mean travel ticks " << statistics.meanTravelTicks << std::endl;
+    for(const auto& road : statistics.meanThroughput)
+    {
+        std::cout << "road " << road.first << " mean throughput " << road.second << std::endl;
+    }
+    return snapshotsWritten ? 0 : 1;
+}
+
+}
 
 int main(int argc, char *argv[])
 {
+    if(argc > 1 && std::string{argv[1]} == EXPORTARGUMENT)
+    {
+        return exportTrajectory(argc, argv);
+    }
+    if(argc > 1 && std::string{argv[1]} == ENSEMBLEARGUMENT)
+    {
+        return runEnsemble(argc, argv);
+    }
+
     auto application = new QApplication{argc, argv};
     auto mainWindow = new trafficsimulation::MainWindow{};
     mainWindow->show();
@@ -1,26 +1,54 @@
 #include "include/MainWindow.hpp"
 #include "ui_mainwindow.h"
 
+#include <algorithm>
+
 #include <QGraphicsScene>
+#include <QScrollBar>
 
-#include "include/view/PathPainters.hpp"
+#include "include/common/Point.hpp"
+#include "include/view/DensityLayer.hpp"
+#include "include/view/NetworkLayer.hpp"
 #include "include/view/PointPainters.hpp"
 #include "include/controller/SimulationController.hpp"
 
 namespace trafficsimulation
 {
 
+/* space kept between junction and edge of scene */
+constexpr auto SCENEMARGIN = qreal{20};
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow{parent}
     , ui_{new Ui::MainWindow}
     , scene_{new QGraphicsScene(this)}
+    , networkLayer_{nullptr}
+    , driverLayer_{nullptr}
+    , pedestrianLayer_{nullptr}
+    , densityLayer_{nullptr}
     , controller_{std::make_unique<controller::SimulationController>(this)}
+    , destinationJunctions_{}
+    , generateMapEnabled_{true}
 {
     ui_->setupUi(this);
     ui_->graphicsView->setScene(scene_);
     ui_->graphicsView->installEventFilter(new GraphicsViewFilter{});
+    auto *zoomFilter = new GraphicsViewZoomFilter{ui_->graphicsView};
+    ui_->graphicsView->viewport()->installEventFilter(zoomFilter);
+    ui_->graphicsView->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    ui_->graphicsView->setDragMode(QGraphicsView::ScrollHandDrag);
 
     scene_->setSceneRect(0, 0, SCENEWIDTH, SCENEHEIGHT);
+    // agents move every tick, keeping them in index costs more than it saves
+    scene_->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    // engine skips agents outside of visible area, it changes on scroll and zoom
+    connect(zoomFilter, &GraphicsViewZoomFilter::zoomed,
+        this, &MainWindow::publishVisibleArea);
+    connect(ui_->graphicsView->horizontalScrollBar(), &QScrollBar::valueChanged,
+        this, &MainWindow::publishVisibleArea);
+    connect(ui_->graphicsView->verticalScrollBar(), &QScrollBar::valueChanged,
+        this, &MainWindow::publishVisibleArea);
 
     connect(ui_->addJunctionButton, &QPushButton::clicked,
         this, [this](){
@@ -46,6 +74,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui_->resetButton, &QPushButton::clicked,
         this, [this](){
             ui_->generateMapButton->setEnabled(true);
+            disableReplayControls();
             controller_->resetSimulation();
         });
     connect(ui_->generateMapButton, &QPushButton::clicked,
@@ -55,6 +84,18 @@ MainWindow::MainWindow(QWidget *parent)
         });
     connect(ui_->selectDestinationPushButton, &QPushButton::clicked,
         this, [this](){ controller_->setDestination(); });
+    connect(ui_->saveCheckpointButton, &QPushButton::clicked,
+        this, &MainWindow::handleSaveCheckpointButtonClick);
+    connect(ui_->loadCheckpointButton, &QPushButton::clicked,
+        this, &MainWindow::handleLoadCheckpointButtonClick);
+    connect(ui_->loadReplayButton, &QPushButton::clicked,
+        this, &MainWindow::handleLoadReplayButtonClick);
+    connect(ui_->playPauseReplayButton, &QPushButton::clicked,
+        this, &MainWindow::handlePlayPauseReplayButtonClick);
+    connect(ui_->replaySlider, &QSlider::sliderMoved,
+        this, [this](int frame){ controller_->seekReplay(frame); });
+    connect(ui_->replaySpeedDoubleSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+        this, [this](double speed){ controller_->setReplaySpeed(static_cast<float>(speed)); });
 }
 
 MainWindow::~MainWindow()
@@ -66,6 +107,11 @@ MainWindow::~MainWindow()
 void MainWindow::resetScene()
 {
     scene_->clear();
+    scene_->setSceneRect(0, 0, SCENEWIDTH, SCENEHEIGHT);
+    networkLayer_ = nullptr;
+    driverLayer_ = nullptr;
+    pedestrianLayer_ = nullptr;
+    densityLayer_ = nullptr;
 }
 
 void MainWindow::setDestinations(const std::vector<view::dialogs::Junction> destinationJunctions)
@@ -95,39 +141,111 @@ uint32_t MainWindow::getRefreshTimeout() const
     return ui_->refreshTimeoutSpinBox->value();
 }
 
+bool MainWindow::isRecordingEnabled() const
+{
+    return ui_->recordCheckBox->isChecked();
+}
+
+float MainWindow::getReplaySpeed() const
+{
+    return static_cast<float>(ui_->replaySpeedDoubleSpinBox->value());
+}
+
+void MainWindow::setReplayLength(const uint64_t frameCount)
+{
+    ui_->replaySlider->setRange(0, static_cast<int>(frameCount - 1));
+    ui_->replaySlider->setValue(0);
+    ui_->replaySlider->setEnabled(true);
+    ui_->playPauseReplayButton->setText("Play");
+    ui_->playPauseReplayButton->setEnabled(true);
+}
+
+void MainWindow::setReplayPosition(const uint64_t frame)
+{
+    ui_->replaySlider->setValue(static_cast<int>(frame));
+    if(static_cast<int>(frame) == ui_->replaySlider->maximum())
+    {
+        ui_->playPauseReplayButton->setText("Play");
+    }
+}
+
+void MainWindow::extendScene(const common::Point point)
+{
+    const auto junctionRect = QRectF(point.x - SCENEMARGIN, point.y - SCENEMARGIN,
+        2 * SCENEMARGIN, 2 * SCENEMARGIN);
+    if(scene_->sceneRect().contains(junctionRect))
+    {
+        return;
+    }
+    const auto sceneRect = scene_->sceneRect().united(junctionRect);
+    scene_->setSceneRect(sceneRect);
+    if(networkLayer_ != nullptr)
+    {
+        networkLayer_->setSceneRect(sceneRect);
+    }
+    for(const auto& agentLayer : {driverLayer_, pedestrianLayer_})
+    {
+        if(agentLayer != nullptr)
+        {
+            agentLayer->setSceneRect(sceneRect);
+        }
+    }
+    if(densityLayer_ != nullptr)
+    {
+        densityLayer_->setSceneRect(sceneRect);
+    }
+}
+
 interface::PointPainter* MainWindow::addJunctionPainter()
 {
-    auto painter = new view::JunctionPainter{};
-    scene_->addItem(painter);
-    return painter;
+    return getNetworkLayer()->addJunction();
 }
 
 interface::PointPainter* MainWindow::addDriverPainter()
 {
-    auto painter = new view::DriverPainter{};
-    scene_->addItem(painter);
-    return painter;
+    if(driverLayer_ == nullptr)
+    {
+        driverLayer_ = new view::DriverLayer{scene_->sceneRect()};
+        scene_->addItem(driverLayer_);
+    }
+    return driverLayer_->addAgent();
 }
 
 interface::PointPainter* MainWindow::addPedestrianPainter()
 {
-    auto painter = new view::PedestrianPainter{};
-    scene_->addItem(painter);
-    return painter;
+    if(pedestrianLayer_ == nullptr)
+    {
+        pedestrianLayer_ = new view::PedestrianLayer{scene_->sceneRect()};
+        scene_->addItem(pedestrianLayer_);
+    }
+    return pedestrianLayer_->addAgent();
 }
 
 interface::LinePainter* MainWindow::addRoadPainter()
 {
-    auto painter = new view::RoadPainter{};
-    scene_->addItem(painter);
-    return painter;
+    return getNetworkLayer()->addRoad();
 }
 
 interface::LinePainter* MainWindow::addPavementPainter()
 {
-    auto painter = new view::PavementPainter{};
-    scene_->addItem(painter);
-    return painter;
+    return getNetworkLayer()->addPavement();
+}
+
+interface::DensityPainter* MainWindow::addDensityPainter()
+{
+    densityLayer_ = new view::DensityLayer{scene_->sceneRect()};
+    scene_->addItem(densityLayer_);
+    return densityLayer_;
+}
+
+view::NetworkLayer* MainWindow::getNetworkLayer()
+{
+    if(networkLayer_ == nullptr)
+    {
+        networkLayer_ = new view::NetworkLayer{scene_->sceneRect()};
+        scene_->addItem(networkLayer_);
+    }
+    return networkLayer_;
 }
 
 void MainWindow::handleStartStopButtonClick()
@@ -135,18 +253,7 @@ void MainWindow::handleStartStopButtonClick()
     if(controller_->isSimulationRunning())
     {
         controller_->stopSimulation();
-        ui_->startStopButton->setText("Start");
-
-        for(const auto& button : {ui_->addJunctionButton, ui_->addPavementButton,
-            ui_->addRoadButton, ui_->addDriverButton, ui_->addPedestrianButton, ui_->resetButton})
-        {
-            button->setEnabled(true);
-        }
-        ui_->refreshTimeoutSpinBox->setEnabled(true);
-        ui_->selectDestinationPushButton->setEnabled(false);
-        ui_->selectDestinationComboBox->setEnabled(false);
-        ui_->selectDestinationComboBox->clear();
-
+        enableStoppedControls();
         return;
     }
     if(controller_->startSimulation())
@@ -158,8 +265,104 @@ void MainWindow::handleStartStopButtonClick()
         {
             button->setEnabled(false);
         }
+        // engine thread iterates junctions and roads that generated map would add
+        generateMapEnabled_ = ui_->generateMapButton->isEnabled();
+        ui_->generateMapButton->setEnabled(false);
+        ui_->refreshTimeoutSpinBox->setEnabled(false);
+        ui_->recordCheckBox->setEnabled(false);
+        ui_->loadReplayButton->setEnabled(false);
+        ui_->loadCheckpointButton->setEnabled(false);
+    }
+}
+
+void MainWindow::handleSaveCheckpointButtonClick()
+{
+    if(!controller_->saveCheckpoint())
+    {
+        enableStoppedControls();
+    }
+}
+
+void MainWindow::enableStoppedControls()
+{
+    ui_->startStopButton->setText("Start");
+
+    for(const auto& button : {ui_->addJunctionButton, ui_->addPavementButton,
+        ui_->addRoadButton, ui_->addDriverButton, ui_->addPedestrianButton, ui_->resetButton})
+    {
+        button->setEnabled(true);
+    }
+    ui_->generateMapButton->setEnabled(generateMapEnabled_);
+    ui_->refreshTimeoutSpinBox->setEnabled(true);
+    ui_->recordCheckBox->setEnabled(true);
+    ui_->loadReplayButton->setEnabled(true);
+    ui_->loadCheckpointButton->setEnabled(true);
+    ui_->selectDestinationPushButton->setEnabled(false);
+    ui_->selectDestinationComboBox->setEnabled(false);
+    ui_->selectDestinationComboBox->clear();
+}
+
+void MainWindow::handleLoadCheckpointButtonClick()
+{
+    if(controller_->loadCheckpoint())
+    {
+        ui_->generateMapButton->setEnabled(false);
+        disableReplayControls();
+    }
+}
+
+void MainWindow::handleLoadReplayButtonClick()
+{
+    if(!controller_->loadReplay())
+    {
+        return;
+    }
+    for(const auto& button : {ui_->addJunctionButton, ui_->addPavementButton,
+        ui_->addRoadButton, ui_->addDriverButton, ui_->addPedestrianButton,
+        ui_->generateMapButton, ui_->startStopButton, ui_->saveCheckpointButton})
+    {
+        button->setEnabled(false);
+    }
+    ui_->recordCheckBox->setEnabled(false);
+}
+
+void MainWindow::handlePlayPauseReplayButtonClick()
+{
+    if(controller_->toggleReplay())
+    {
+        ui_->playPauseReplayButton->setText("Pause");
         ui_->refreshTimeoutSpinBox->setEnabled(false);
+        return;
     }
+    ui_->playPauseReplayButton->setText("Play");
+    ui_->refreshTimeoutSpinBox->setEnabled(true);
+}
+
+void MainWindow::disableReplayControls()
+{
+    for(const auto& button : {ui_->addJunctionButton, ui_->addPavementButton,
+        ui_->addRoadButton, ui_->addDriverButton, ui_->addPedestrianButton,
+        ui_->startStopButton, ui_->saveCheckpointButton})
+    {
+        button->setEnabled(true);
+    }
+    ui_->recordCheckBox->setEnabled(true);
+    ui_->refreshTimeoutSpinBox->setEnabled(true);
+    ui_->playPauseReplayButton->setText("Play");
+    ui_->playPauseReplayButton->setEnabled(false);
+    ui_->replaySlider->setEnabled(false);
+}
+
+void MainWindow::publishVisibleArea()
+{
+    const auto area = ui_->graphicsView->mapToScene(
+        ui_->graphicsView->viewport()->rect()).boundingRect();
+    const auto toPoint = [](const qreal x, const qreal y){
+        return common::Point{static_cast<int32_t>(std::clamp<qreal>(x, INT32_MIN, INT32_MAX)),
+            static_cast<int32_t>(std::clamp<qreal>(y, INT32_MIN, INT32_MAX))};
+    };
+    controller_->setVisibleArea(toPoint(area.left(), area.top()),
+        toPoint(area.right(), area.bottom()));
 }
 
 } // trafficsimulation
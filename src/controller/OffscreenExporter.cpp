@@ -0,0 +1,121 @@
+#include "../include/controller/OffscreenExporter.hpp"
+
+#include <algorithm>
+
+#include "../include/common/Point.hpp"
+#include "../include/model/Simulation.hpp"
+#include "../include/model/TrajectoryReplay.hpp"
+#include "../include/view/FrameRenderer.hpp"
+
+namespace trafficsimulation::controller
+{
+
+namespace
+{
+
+std::optional<std::string> validateSettings(const ExportSettings& settings)
+{
+    if(settings.width == 0 || settings.height == 0)
+    {
+        return "Exported images have to be at least one pixel wide and high";
+    }
+    return {};
+}
+
+}
+
+OffscreenExporter::OffscreenExporter(const ExportSettings settings)
+    : settings_{settings}
+{
+}
+
+OffscreenExporter::~OffscreenExporter() = default;
+
+std::optional<std::string> OffscreenExporter::exportTrajectory(const std::string& trajectoryPath,
+    const std::string& outputPath) const
+{
+    const auto settingsResult = validateSettings(settings_);
+    if(settingsResult.has_value())
+    {
+        return settingsResult;
+    }
+    auto replay = model::TrajectoryReplay{};
+    const auto loadResult = replay.load(trajectoryPath);
+    if(loadResult.has_value())
+    {
+        return loadResult;
+    }
+
+    const auto renderer = view::FrameRenderer{replay.getLayout(),
+        QSize(settings_.width, settings_.height)};
+    auto exporter = view::FrameExporter{settings_.format};
+    const auto openResult = exporter.open(outputPath);
+    if(openResult.has_value())
+    {
+        return openResult;
+    }
+
+    const auto interval = std::max(settings_.frameInterval, uint64_t{1});
+    for(auto frame = uint64_t{0}; frame < replay.getFrameCount(); frame += interval)
+    {
+        const auto currentFrame = replay.readFrame(frame);
+        if(!currentFrame.has_value())
+        {
+            exporter.close();
+            return "Could not read frame " + std::to_string(frame) + " of " + trajectoryPath;
+        }
+        const auto writeResult = exporter.write(renderer.render(currentFrame.value()));
+        if(writeResult.has_value())
+        {
+            exporter.close();
+            return writeResult;
+        }
+    }
+    return exporter.close();
+}
+
+std::optional<std::string> OffscreenExporter::exportSimulation(model::Simulation& simulation,
+    const uint64_t ticks, const std::string& outputPath) const
+{
+    const auto settingsResult = validateSettings(settings_);
+    if(settingsResult.has_value())
+    {
+        return settingsResult;
+    }
+    // validates simulation and calculates its routes before anything is written
+    const auto runResult = simulation.run(0);
+    if(runResult.has_value())
+    {
+        return runResult;
+    }
+
+    simulation.setVisibleArea(common::Point{INT32_MIN, INT32_MIN},
+        common::Point{INT32_MAX, INT32_MAX});
+    const auto renderer = view::FrameRenderer{simulation.captureLayout(),
+        QSize(settings_.width, settings_.height)};
+    auto exporter = view::FrameExporter{settings_.format};
+    const auto openResult = exporter.open(outputPath);
+    if(openResult.has_value())
+    {
+        return openResult;
+    }
+
+    const auto interval = std::max(settings_.frameInterval, uint64_t{1});
+    auto result = exporter.write(renderer.render(simulation.captureFrame()));
+    for(auto tick = uint64_t{0}; tick < ticks && !result.has_value(); tick += interval)
+    {
+        result = simulation.run(std::min(interval, ticks - tick));
+        if(!result.has_value())
+        {
+            result = exporter.write(renderer.render(simulation.captureFrame()));
+        }
+    }
+    if(result.has_value())
+    {
+        exporter.close();
+        return result;
+    }
+    return exporter.close();
+}
+
+} // trafficsimulation::controller
@@ -1,19 +1,24 @@
 #include "../include/controller/SimulationController.hpp"
 
+#include <ctime>
 #include <map>
 
+#include <QFileDialog>
 #include <QMessageBox>
 #include <QString>
 
 #include "../include/MainWindow.hpp"
 #include "../include/common/Point.hpp"
+#include "../include/interface/DensityPainter.hpp"
 #include "../include/interface/PointPainter.hpp"
 #include "../include/interface/LinePainter.hpp"
+#include "../include/model/Checkpoint.hpp"
 #include "../include/model/Driver.hpp"
 #include "../include/model/Junction.hpp"
 #include "../include/model/Pedestrian.hpp"
 #include "../include/model/RoadCondition.hpp"
 #include "../include/model/Simulation.hpp"
+#include "../include/model/TrajectoryReplay.hpp"
 
 #include "../include/view/dialogs/CreateDriverDialog.hpp"
 #include "../include/view/dialogs/CreateJunctionDialog.hpp"
@@ -34,17 +39,25 @@ struct NewRoad
     uint32_t lenght;
     model::RoadCondition roadCondition;
     uint32_t speedLimit;
+    uint32_t laneCount;
 };
 
 }
 
 constexpr auto EDGEOFFSET = uint32_t{20};
+/* junctions can be placed this far from origin of world, scene grows to show them */
+constexpr auto MAXJUNCTIONCOORDINATE = uint32_t{1000000};
+constexpr auto TRAJECTORYFILEFILTER = "Trajectory recording (*.trj)";
+constexpr auto CHECKPOINTFILEFILTER = "Simulation checkpoint (*.chk)";
 
 SimulationController::SimulationController(MainWindow *mainWindow)
     : mainWindow_{mainWindow}
     , simulation_{nullptr}
+    , replay_{nullptr}
+    , visibleTopLeft_{0, 0}
+    , visibleBottomRight_{static_cast<int32_t>(SCENEWIDTH), static_cast<int32_t>(SCENEHEIGHT)}
 {
-    createSimulation();
+    createSimulation(static_cast<uint64_t>(std::time(0)));
 }
 
 SimulationController::~SimulationController() = default;
@@ -52,9 +65,10 @@ SimulationController::~SimulationController() = default;
 void SimulationController::addJunction()
 {
     auto dialog = view::dialogs::CreateJunctionDialog{EDGEOFFSET, SCENEWIDTH - EDGEOFFSET,
-        SCENEHEIGHT - EDGEOFFSET, mainWindow_};
+        SCENEHEIGHT - EDGEOFFSET, MAXJUNCTIONCOORDINATE, mainWindow_};
     if(dialog.exec() == QDialog::Accepted)
     {
+        mainWindow_->extendScene(dialog.getPoint());
         simulation_->addJunction(dialog.getPoint(), mainWindow_->addJunctionPainter());
     }
 }
@@ -116,7 +130,7 @@ void SimulationController::addRoad()
             [endId = dialog.getEndId()](const auto j){ return j->getId() == endId; });
 
         simulation_->addRoad(*startJunction, *endJunction, dialog.getLength(),
-            dialog.getRoadCondition(), dialog.getSpeedLimit(),
+            dialog.getRoadCondition(), dialog.getSpeedLimit(), dialog.getLaneCount(),
             mainWindow_->addRoadPainter());
 
         if(dialog.bothDirections())
@@ -128,7 +142,7 @@ void SimulationController::addRoad()
                 (*startJunction)->getId()) == std::cend(connections))
             {
                 simulation_->addRoad(*endJunction, *startJunction, dialog.getLength(),
-                    dialog.getRoadCondition(), dialog.getSpeedLimit(),
+                    dialog.getRoadCondition(), dialog.getSpeedLimit(), dialog.getLaneCount(),
                     mainWindow_->addRoadPainter());
             }
         }
@@ -210,13 +224,13 @@ void SimulationController::generateBasicMap()
         {SCENEWIDTH / 2, SCENEHEIGHT / 2}};
 
     const auto newRoads = std::vector<NewRoad>{
-        {0, 1, 1000, model::RoadCondition::NoPotHoles, 70},
-        {0, 2, 350, model::RoadCondition::New, 50},
-        {0, 4, 500, model::RoadCondition::Offroad, 50},
-        {1, 3, 2000, model::RoadCondition::SomePotHoles, 70},
-        {1, 4, 1000, model::RoadCondition::New, 90},
-        {2, 3, 500, model::RoadCondition::SomePotHoles, 30},
-        {2, 4, 2000, model::RoadCondition::LotsOfPotHoles, 120}};
+        {0, 1, 1000, model::RoadCondition::NoPotHoles, 70, 1},
+        {0, 2, 350, model::RoadCondition::New, 50, 1},
+        {0, 4, 500, model::RoadCondition::Offroad, 50, 1},
+        {1, 3, 2000, model::RoadCondition::SomePotHoles, 70, 1},
+        {1, 4, 1000, model::RoadCondition::New, 90, 2},
+        {2, 3, 500, model::RoadCondition::SomePotHoles, 30, 1},
+        {2, 4, 2000, model::RoadCondition::LotsOfPotHoles, 120, 2}};
 
     auto msgBoxText = QString{"Added following:\n"
         "Junctions; 0: [" + QString::number(EDGEOFFSET) + ", " + QString::number(EDGEOFFSET) + "]"};
@@ -234,7 +248,8 @@ void SimulationController::generateBasicMap()
             .append(" - ").append(QString::number(newRoad.endJunctionIterator))
             .append("; length: ").append(QString::number(newRoad.lenght))
             .append("m, road condition: ").append(QString::fromStdString(toString(newRoad.roadCondition)))
-            .append(", speed limit: ").append(QString::number(newRoad.speedLimit)).append("\n");
+            .append(", speed limit: ").append(QString::number(newRoad.speedLimit))
+            .append(", lanes: ").append(QString::number(newRoad.laneCount)).append("\n");
     }
     msgBoxText.append("All roads are 2 both directions and have pavements");
 
@@ -252,11 +267,11 @@ void SimulationController::generateBasicMap()
     {
         simulation_->addRoad(junctions[newRoad.startJunctionIterator],
             junctions[newRoad.endJunctionIterator], newRoad.lenght * 1000, newRoad.roadCondition,
-            newRoad.speedLimit * 10, mainWindow_->addRoadPainter());
+            newRoad.speedLimit * 10, newRoad.laneCount, mainWindow_->addRoadPainter());
 
         simulation_->addRoad(junctions[newRoad.endJunctionIterator],
             junctions[newRoad.startJunctionIterator], newRoad.lenght * 1000, newRoad.roadCondition,
-            newRoad.speedLimit * 10, mainWindow_->addRoadPainter());
+            newRoad.speedLimit * 10, newRoad.laneCount, mainWindow_->addRoadPainter());
 
         simulation_->addPavement(junctions[newRoad.startJunctionIterator],
             junctions[newRoad.endJunctionIterator], newRoad.lenght * 1000,
@@ -270,22 +285,31 @@ void SimulationController::generateBasicMap()
 
 void SimulationController::setDestination()
 {
-    auto destination = mainWindow_->getDestination();
-    for(const auto& driver : simulation_->getDrivers())
-    {
-        driver->setDestination(destination);
-    }
-    for(const auto& pedestrian : simulation_->getPedestrians())
-    {
-        pedestrian->setDestination(destination);
-    }
+    simulation_->setDestination(mainWindow_->getDestination());
 }
 
 bool SimulationController::startSimulation()
 {
+    if(mainWindow_->isRecordingEnabled() && !simulation_->isRecording())
+    {
+        const auto filePath = QFileDialog::getSaveFileName(mainWindow_, "Save recording",
+            QString{}, TRAJECTORYFILEFILTER);
+        if(!filePath.isEmpty())
+        {
+            const auto recordingResult = simulation_->startRecording(filePath.toStdString());
+            if(recordingResult.has_value())
+            {
+                auto msgBox = new QMessageBox{mainWindow_};
+                msgBox->setText(QString::fromStdString(recordingResult.value()));
+                msgBox->exec();
+                return false;
+            }
+        }
+    }
     auto result = simulation_->start(mainWindow_->getRefreshTimeout());
     if(result.has_value())
     {
+        simulation_->stopRecording();
         auto msgBox = new QMessageBox{mainWindow_};
         msgBox->setText(QString::fromStdString(result.value()));
         msgBox->exec();
@@ -303,6 +327,7 @@ bool SimulationController::startSimulation()
 void SimulationController::stopSimulation()
 {
     simulation_->stop();
+    simulation_->stopRecording();
 }
 
 bool SimulationController::isSimulationRunning()
@@ -312,16 +337,243 @@ bool SimulationController::isSimulationRunning()
 
 void SimulationController::resetSimulation()
 {
+    resetSimulation(static_cast<uint64_t>(std::time(0)));
+}
+
+bool SimulationController::saveCheckpoint()
+{
+    const auto filePath = QFileDialog::getSaveFileName(mainWindow_, "Save checkpoint",
+        QString{}, CHECKPOINTFILEFILTER);
+    if(filePath.isEmpty())
+    {
+        return true;
+    }
+    /* engine thread is stopped, so checkpoint is taken between ticks */
+    const auto wasRunning = simulation_->isRunning();
+    simulation_->stop();
+    auto result = model::writeCheckpoint(filePath.toStdString(),
+        simulation_->createCheckpoint());
+    auto restartFailed = false;
+    if(wasRunning)
+    {
+        const auto startResult = simulation_->start(mainWindow_->getRefreshTimeout());
+        if(startResult.has_value())
+        {
+            simulation_->stopRecording();
+            restartFailed = true;
+            result = result.has_value() ? result.value() + "\n" + startResult.value()
+                : startResult.value();
+        }
+    }
+    if(result.has_value())
+    {
+        auto msgBox = new QMessageBox{mainWindow_};
+        msgBox->setText(QString::fromStdString(result.value()));
+        msgBox->exec();
+    }
+    return !restartFailed;
+}
+
+bool SimulationController::loadCheckpoint()
+{
+    const auto filePath = QFileDialog::getOpenFileName(mainWindow_, "Open checkpoint",
+        QString{}, CHECKPOINTFILEFILTER);
+    if(filePath.isEmpty())
+    {
+        return false;
+    }
+
+    auto checkpoint = model::Checkpoint{};
+    auto result = model::readCheckpoint(filePath.toStdString(), checkpoint);
+    if(result.has_value())
+    {
+        auto msgBox = new QMessageBox{mainWindow_};
+        msgBox->setText(QString::fromStdString(result.value()));
+        msgBox->exec();
+        return false;
+    }
+    resetSimulation(checkpoint.seed);
+
+    /* first junction is created by simulation itself */
+    for(auto iterator = std::size_t{1}; iterator < std::size(checkpoint.junctions); ++iterator)
+    {
+        mainWindow_->extendScene(checkpoint.junctions[iterator].position);
+        simulation_->addJunction(checkpoint.junctions[iterator].position,
+            mainWindow_->addJunctionPainter());
+    }
+    const auto junctions = simulation_->getJunctions();
+    const auto findJunction = [&junctions](const uint32_t junctionId)
+        {
+            return std::find_if(junctions.cbegin(), junctions.cend(),
+                [junctionId](const auto j){ return j->getId() == junctionId; });
+        };
+
+    for(const auto& path : checkpoint.paths)
+    {
+        const auto startJunction = findJunction(path.startJunctionId);
+        const auto endJunction = findJunction(path.endJunctionId);
+        if(startJunction == junctions.cend() || endJunction == junctions.cend())
+        {
+            result = "Checkpoint " + filePath.toStdString() + " is corrupted";
+            break;
+        }
+        if(path.pathType == model::PathType::Road)
+        {
+            simulation_->addRoad(*startJunction, *endJunction, path.length,
+                path.roadCondition, path.speedLimit, path.laneCount,
+                mainWindow_->addRoadPainter());
+            continue;
+        }
+        simulation_->addPavement(*startJunction, *endJunction, path.length,
+            mainWindow_->addPavementPainter());
+    }
+    for(const auto& driver : checkpoint.drivers)
+    {
+        simulation_->addDriver(driver.maxAcceleration, driver.maxDeceleration,
+            driver.accelerationRate, driver.minDistanceToVehicleAhead, driver.maxSpeedOverLimit,
+            driver.roadConditionSpeedModifier, mainWindow_->addDriverPainter());
+    }
+    for(const auto& pedestrian : checkpoint.pedestrians)
+    {
+        simulation_->addPedestrian(pedestrian.maxSpeed, mainWindow_->addPedestrianPainter());
+    }
+
+    if(!result.has_value())
+    {
+        result = simulation_->restoreCheckpoint(checkpoint);
+    }
+    if(result.has_value())
+    {
+        resetSimulation();
+        auto msgBox = new QMessageBox{mainWindow_};
+        msgBox->setText(QString::fromStdString(result.value()));
+        msgBox->exec();
+        return false;
+    }
+    return true;
+}
+
+bool SimulationController::loadReplay()
+{
+    const auto filePath = QFileDialog::getOpenFileName(mainWindow_, "Open recording",
+        QString{}, TRAJECTORYFILEFILTER);
+    if(filePath.isEmpty())
+    {
+        return false;
+    }
+
+    auto replay = std::make_unique<model::TrajectoryReplay>();
+    const auto result = replay->load(filePath.toStdString());
+    if(result.has_value())
+    {
+        auto msgBox = new QMessageBox{mainWindow_};
+        msgBox->setText(QString::fromStdString(result.value()));
+        msgBox->exec();
+        return false;
+    }
+    resetSimulation();
+    replay_ = std::move(replay);
+
+    const auto& layout = replay_->getLayout();
+    for(const auto& junction : layout.junctions)
+    {
+        mainWindow_->extendScene(junction);
+        auto painter = mainWindow_->addJunctionPainter();
+        painter->setPoint(junction);
+        painter->paint();
+    }
+    for(const auto& road : layout.roads)
+    {
+        auto painter = mainWindow_->addRoadPainter();
+        painter->setPoints(road.startPoint, road.endPoint);
+        painter->paint();
+    }
+    for(const auto& pavement : layout.pavements)
+    {
+        auto painter = mainWindow_->addPavementPainter();
+        painter->setPoints(pavement.startPoint, pavement.endPoint);
+        painter->paint();
+    }
+
+    auto driverPainters = std::vector<interface::PointPainter*>{};
+    for(auto iterator = uint32_t{0}; iterator < replay_->getMaxDriverCount(); ++iterator)
+    {
+        driverPainters.push_back(mainWindow_->addDriverPainter());
+    }
+    auto pedestrianPainters = std::vector<interface::PointPainter*>{};
+    for(auto iterator = uint32_t{0}; iterator < replay_->getMaxPedestrianCount(); ++iterator)
+    {
+        pedestrianPainters.push_back(mainWindow_->addPedestrianPainter());
+    }
+    replay_->setPainters(driverPainters, pedestrianPainters);
+
+    QObject::connect(replay_.get(), &model::TrajectoryReplay::frameChanged, mainWindow_,
+        [this](quint64 frame){ mainWindow_->setReplayPosition(frame); });
+    mainWindow_->setReplayLength(replay_->getFrameCount());
+    replay_->setSpeed(mainWindow_->getReplaySpeed());
+    replay_->seek(0);
+    return true;
+}
+
+bool SimulationController::toggleReplay()
+{
+    if(replay_ == nullptr)
+    {
+        return false;
+    }
+    if(replay_->isPlaying())
+    {
+        replay_->pause();
+        return false;
+    }
+    replay_->play(mainWindow_->getRefreshTimeout());
+    return replay_->isPlaying();
+}
+
+void SimulationController::seekReplay(const uint64_t frame)
+{
+    if(replay_ == nullptr)
+    {
+        return;
+    }
+    replay_->seek(frame);
+}
+
+void SimulationController::setReplaySpeed(const float speed)
+{
+    if(replay_ == nullptr)
+    {
+        return;
+    }
+    replay_->setSpeed(speed);
+}
+
+void SimulationController::setVisibleArea(const common::Point topLeft,
+    const common::Point bottomRight)
+{
+    visibleTopLeft_ = topLeft;
+    visibleBottomRight_ = bottomRight;
+    if(simulation_ != nullptr)
+    {
+        simulation_->setVisibleArea(topLeft, bottomRight);
+    }
+}
+
+void SimulationController::resetSimulation(const uint64_t seed)
+{
+    replay_ = nullptr;
     simulation_ = nullptr;
     mainWindow_->resetScene();
-    createSimulation();
+    createSimulation(seed);
 }
 
-void SimulationController::createSimulation()
+void SimulationController::createSimulation(const uint64_t seed)
 {
-    simulation_ = std::make_unique<model::Simulation>();
+    simulation_ = std::make_unique<model::Simulation>(seed);
     simulation_->setBasePrinters(std::move(mainWindow_->addJunctionPainter()),
         std::move(mainWindow_->addRoadPainter()), std::move(mainWindow_->addPavementPainter()));
+    simulation_->setDensityPainter(mainWindow_->addDensityPainter());
+    simulation_->setVisibleArea(visibleTopLeft_, visibleBottomRight_);
 }
 
 std::vector<view::dialogs::NotConnectedJunction> SimulationController::findNotConnectedJunctions(
@@ -5,7 +5,10 @@
 
 #include <QMainWindow>
 #include <QEvent>
+#include <QGraphicsView>
+#include <QWheelEvent>
 
+#include "common/Point.hpp"
 #include "view/dialogs/NotConnectedJunction.hpp"
 
 QT_BEGIN_NAMESPACE
@@ -17,15 +20,26 @@ class QGraphicsScene;
 namespace trafficsimulation::controller { class SimulationController; }
 namespace trafficsimulation::interface
 {
+class DensityPainter;
 class PointPainter;
 class LinePainter;
 }
+namespace trafficsimulation::view
+{
+class AgentLayer;
+class DensityLayer;
+class NetworkLayer;
+}
 
 namespace trafficsimulation
 {
 
+/* size of scene before network grows beyond it, one unit of world is one pixel at zoom 1 */
 constexpr auto SCENEWIDTH = uint32_t{1300};
 constexpr auto SCENEHEIGHT = uint32_t{820};
+constexpr auto ZOOMFACTOR = qreal{1.25};
+constexpr auto MINZOOM = qreal{0.25};
+constexpr auto MAXZOOM = qreal{8};
 
 /* reduce unnecessary repaints */
 class GraphicsViewFilter : public QObject
@@ -42,6 +56,42 @@ protected:
     };
 };
 
+/* zooms graphics view with mouse wheel, installed on its viewport */
+class GraphicsViewZoomFilter : public QObject
+{
+    Q_OBJECT
+
+public:
+    GraphicsViewZoomFilter(QGraphicsView *graphicsView)
+        : QObject{graphicsView}
+        , graphicsView_{graphicsView}
+    {
+    }
+
+signals:
+    void zoomed();
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override {
+        if(event->type() != QEvent::Wheel)
+        {
+            return QObject::eventFilter(obj, event);
+        }
+        const auto zoom = graphicsView_->transform().m11();
+        const auto factor = static_cast<QWheelEvent*>(event)->angleDelta().y() > 0
+            ? ZOOMFACTOR : 1 / ZOOMFACTOR;
+        if(zoom * factor >= MINZOOM && zoom * factor <= MAXZOOM)
+        {
+            graphicsView_->scale(factor, factor);
+            emit zoomed();
+        }
+        return true;
+    };
+
+private:
+    QGraphicsView *graphicsView_;
+};
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -54,20 +104,45 @@ public:
     void setDestinations(const std::vector<view::dialogs::Junction> destinationJunctions);
     uint32_t getDestination() const;
     uint32_t getRefreshTimeout() const;
+    bool isRecordingEnabled() const;
+    float getReplaySpeed() const;
+    void setReplayLength(const uint64_t frameCount);
+    void setReplayPosition(const uint64_t frame);
+    void extendScene(const common::Point point);
 
     interface::PointPainter* addJunctionPainter();
     interface::PointPainter* addDriverPainter();
     interface::PointPainter* addPedestrianPainter();
     interface::LinePainter* addRoadPainter();
     interface::LinePainter* addPavementPainter();
+    interface::DensityPainter* addDensityPainter();
 
 private:
+    view::NetworkLayer* getNetworkLayer();
     void handleStartStopButtonClick();
+    void handleSaveCheckpointButtonClick();
+    /*!
+     * \brief enableStoppedControls
+     *
+     * Enables controls that can change simulation that is not running
+     */
+    void enableStoppedControls();
+    void handleLoadCheckpointButtonClick();
+    void handleLoadReplayButtonClick();
+    void handlePlayPauseReplayButtonClick();
+    void disableReplayControls();
+    void publishVisibleArea();
 
     Ui::MainWindow *ui_;
     QGraphicsScene *scene_;
+    view::NetworkLayer *networkLayer_;
+    view::AgentLayer *driverLayer_;
+    view::AgentLayer *pedestrianLayer_;
+    view::DensityLayer *densityLayer_;
     std::unique_ptr<controller::SimulationController> controller_;
     std::vector<view::dialogs::Junction> destinationJunctions_;
+    /* generateMapButton is disabled while simulation runs, state is restored after it */
+    bool generateMapEnabled_;
 };
 
 } // trafficsimulation::view
@@ -0,0 +1,104 @@
+#ifndef BINARYSTREAM_HPP
+#define BINARYSTREAM_HPP
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace trafficsimulation::common
+{
+
+/* readVector grows vector by at most this number of bytes before reading them */
+constexpr auto READVECTORCHUNKSIZE = std::size_t{1} << 16;
+
+/*!
+ * \brief writeValue
+ * \tparam typename T - trivially copyable type
+ * \param std::ostream& stream
+ * \param T value
+ *
+ * Writes raw bytes of value to binary stream
+ */
+template<typename T>
+inline void writeValue(std::ostream& stream, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/*!
+ * \brief readValue
+ * \tparam typename T - trivially copyable type
+ * \param std::istream& stream
+ * \param T& value
+ * \return true if whole value was read
+ *
+ * Reads raw bytes of value from binary stream
+ */
+template<typename T>
+inline bool readValue(std::istream& stream, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return stream.good();
+}
+
+/*!
+ * \brief writeVector
+ * \tparam typename T - trivially copyable type
+ * \param std::ostream& stream
+ * \param std::vector<T> values
+ *
+ * Writes size of vector followed by its elements
+ */
+template<typename T>
+inline void writeVector(std::ostream& stream, const std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    writeValue(stream, static_cast<uint32_t>(std::size(values)));
+    stream.write(reinterpret_cast<const char*>(values.data()), std::size(values) * sizeof(T));
+}
+
+/*!
+ * \brief readVector
+ * \tparam typename T - trivially copyable type
+ * \param std::istream& stream
+ * \param std::vector<T>& values
+ * \return true if whole vector was read
+ *
+ * Reads vector written by writeVector. Size read from stream is not trusted, vector grows
+ * by READVECTORCHUNKSIZE bytes only after previous ones were read, so corrupted size ends
+ * at end of stream instead of allocating it
+ */
+template<typename T>
+inline bool readVector(std::istream& stream, std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto size = uint32_t{0};
+    if(!readValue(stream, size))
+    {
+        return false;
+    }
+    const auto chunkSize = std::max(READVECTORCHUNKSIZE / sizeof(T), std::size_t{1});
+    values.clear();
+    for(auto remaining = std::size_t{size}; remaining > 0;)
+    {
+        const auto offset = std::size(values);
+        const auto count = std::min(remaining, chunkSize);
+        values.resize(offset + count);
+        stream.read(reinterpret_cast<char*>(values.data() + offset),
+            static_cast<std::streamsize>(count * sizeof(T)));
+        if(!stream.good())
+        {
+            return false;
+        }
+        remaining -= count;
+    }
+    return stream.good();
+}
+
+} // trafficsimulation::common
+
+#endif // BINARYSTREAM_HPP
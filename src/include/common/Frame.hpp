@@ -0,0 +1,66 @@
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Point.hpp"
+
+namespace trafficsimulation::common
+{
+
+/*!
+ * \brief The Line struct
+ * Struct with start and end point of a line
+ */
+struct Line
+{
+    Point startPoint;
+    Point endPoint;
+};
+
+/*!
+ * \brief The Layout struct
+ *
+ * Static part of simulation - positions of junctions and lines of roads and pavements
+ */
+struct Layout
+{
+    std::vector<Point> junctions;
+    std::vector<Line> roads;
+    std::vector<Line> pavements;
+};
+
+/*!
+ * \brief The RoadLoad struct
+ *
+ * Line of road and part of its lanes taken by vehicles, 1 for jammed road
+ */
+struct RoadLoad
+{
+    Line line;
+    float occupancy;
+};
+
+/*!
+ * \brief The Frame struct
+ *
+ * Positions of drivers and pedestrians at given tick of simulation. Order of positions
+ * changes between frames when objects fall asleep, wake up, arrive or respawn, ids of
+ * objects are in the same order as their positions and are the only way to match object
+ * across frames. Loads of roads are in order of roads of Layout, they are not recorded to
+ * trajectory file
+ */
+struct Frame
+{
+    uint64_t tick;
+    std::vector<Point> drivers;
+    std::vector<Point> pedestrians;
+    std::vector<uint32_t> driverIds;
+    std::vector<uint32_t> pedestrianIds;
+    std::vector<RoadLoad> roads;
+};
+
+} // trafficsimulation::common
+
+#endif // FRAME_HPP
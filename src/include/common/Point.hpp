@@ -8,12 +8,13 @@ namespace trafficsimulation::common
 
 /*!
  * \brief The Point class
- * Struct with coordinates x, y of a point
+ * Struct with coordinates x, y of a point in world, view decides how many pixels
+ * one unit of world takes
  */
 struct Point
 {
-    int16_t x;
-    int16_t y;
+    int32_t x;
+    int32_t y;
 };
 
 inline bool operator==(const Point& lhs, const Point& rhs)
@@ -21,6 +22,9 @@ inline bool operator==(const Point& lhs, const Point& rhs)
     return lhs.x == rhs.x && lhs.y == rhs.y;
 }
 
+/* position of objects that are not shown, it is outside of any network */
+constexpr auto HIDDENPOINT = Point{INT32_MIN, INT32_MIN};
+
 } // trafficsimulation::common
 
 #endif // POINT_HPP
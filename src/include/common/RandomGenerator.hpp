@@ -0,0 +1,122 @@
+#ifndef RANDOMGENERATOR_HPP
+#define RANDOMGENERATOR_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace trafficsimulation::common
+{
+
+/*!
+ * \brief The RandomGenerator class
+ *
+ * Counter-based random generator (Philox4x32-10). Each value is a pure function of seed,
+ * streamId and counter, so every object of simulation owns independent stream keyed by
+ * its id. Results do not depend on order in which objects are updated and whole state
+ * of the generator is its counter.
+ */
+class RandomGenerator
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param uint64_t seed
+     * \param uint32_t streamId - id of object that owns generator
+     * \param uint64_t counter - number of values already drawn from stream
+     */
+    RandomGenerator(const uint64_t seed, const uint32_t streamId, const uint64_t counter = 0)
+        : seed_{seed}
+        , streamId_{streamId}
+        , counter_{counter}
+    {
+    }
+
+    /*!
+     * \brief next
+     * \return next value from stream
+     */
+    uint32_t next()
+    {
+        const auto block = generateBlock(counter_ / BLOCKSIZE);
+        return block[counter_++ % BLOCKSIZE];
+    }
+    /*!
+     * \brief nextInRange
+     * \param uint32_t min
+     * \param uint32_t max
+     * \return next value from stream between min and max (inclusive)
+     */
+    uint32_t nextInRange(const uint32_t min, const uint32_t max)
+    {
+        return min + static_cast<uint32_t>(
+            (static_cast<uint64_t>(next()) * (uint64_t{max} - min + 1)) >> 32);
+    }
+    /*!
+     * \brief nextFloat
+     * \return next value from stream between 0 (inclusive) and 1 (exclusive)
+     */
+    float nextFloat()
+    {
+        return static_cast<float>(next() >> 8) / static_cast<float>(uint32_t{1} << 24);
+    }
+
+    uint64_t getSeed() const
+    {
+        return seed_;
+    }
+    uint32_t getStreamId() const
+    {
+        return streamId_;
+    }
+    uint64_t getCounter() const
+    {
+        return counter_;
+    }
+    void setCounter(const uint64_t counter)
+    {
+        counter_ = counter;
+    }
+
+private:
+    static constexpr auto BLOCKSIZE = uint64_t{4};
+    static constexpr auto ROUNDS = uint32_t{10};
+    static constexpr auto MULTIPLIER0 = uint32_t{0xD2511F53};
+    static constexpr auto MULTIPLIER1 = uint32_t{0xCD9E8D57};
+    static constexpr auto WEYL0 = uint32_t{0x9E3779B9};
+    static constexpr auto WEYL1 = uint32_t{0xBB67AE85};
+
+    /*!
+     * \brief generateBlock
+     * \param uint64_t blockIndex
+     * \return four values of stream starting at blockIndex * BLOCKSIZE
+     */
+    std::array<uint32_t, 4> generateBlock(const uint64_t blockIndex) const
+    {
+        auto counter = std::array<uint32_t, 4>{static_cast<uint32_t>(blockIndex),
+            static_cast<uint32_t>(blockIndex >> 32), streamId_, 0};
+        auto key = std::array<uint32_t, 2>{static_cast<uint32_t>(seed_),
+            static_cast<uint32_t>(seed_ >> 32)};
+
+        for(auto round = uint32_t{0}; round < ROUNDS; ++round)
+        {
+            const auto product0 = static_cast<uint64_t>(MULTIPLIER0) * counter[0];
+            const auto product1 = static_cast<uint64_t>(MULTIPLIER1) * counter[2];
+
+            counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<uint32_t>(product1),
+                static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<uint32_t>(product0)};
+            key[0] += WEYL0;
+            key[1] += WEYL1;
+        }
+        return counter;
+    }
+
+    uint64_t seed_;
+    uint32_t streamId_;
+    uint64_t counter_;
+};
+
+} // trafficsimulation::common
+
+#endif // RANDOMGENERATOR_HPP
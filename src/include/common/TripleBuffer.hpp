@@ -0,0 +1,88 @@
+#ifndef TRIPLEBUFFER_HPP
+#define TRIPLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace trafficsimulation::common
+{
+
+/* middle index of TripleBuffer is marked with this bit when it holds not consumed value */
+constexpr auto TRIPLEBUFFERFRESHBIT = uint8_t{0x4};
+constexpr auto TRIPLEBUFFERINDEXMASK = uint8_t{0x3};
+
+/*!
+ * \brief The TripleBuffer class
+ * \tparam typename T - type of published values
+ *
+ * Lock-free exchange of values between one writer thread and one reader thread. Writer
+ * fills back buffer and publishes it, reader takes the latest published buffer. Neither
+ * of them ever waits for the other one, values published between two reads are skipped
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer()
+        : buffers_{}
+        , backIndex_{0}
+        , middleIndex_{1}
+        , frontIndex_{2}
+    {
+    }
+
+    /*!
+     * \brief getBack
+     * \return buffer that writer fills, it is not read until publish() is called
+     */
+    T& getBack()
+    {
+        return buffers_[backIndex_];
+    }
+    /*!
+     * \brief publish
+     *
+     * Called by writer. Makes back buffer the latest value and takes buffer that was
+     * published before as new back buffer
+     */
+    void publish()
+    {
+        backIndex_ = middleIndex_.exchange(backIndex_ | TRIPLEBUFFERFRESHBIT,
+            std::memory_order_acq_rel) & TRIPLEBUFFERINDEXMASK;
+    }
+    /*!
+     * \brief consume
+     * \return true if new value was published since previous call
+     *
+     * Called by reader. If new value was published makes it front buffer
+     */
+    bool consume()
+    {
+        if((middleIndex_.load(std::memory_order_relaxed) & TRIPLEBUFFERFRESHBIT) == 0)
+        {
+            return false;
+        }
+        frontIndex_ = middleIndex_.exchange(frontIndex_, std::memory_order_acq_rel)
+            & TRIPLEBUFFERINDEXMASK;
+        return true;
+    }
+    /*!
+     * \brief getFront
+     * \return latest value taken by consume()
+     */
+    const T& getFront() const
+    {
+        return buffers_[frontIndex_];
+    }
+
+private:
+    std::array<T, 3> buffers_;
+    uint8_t backIndex_;
+    std::atomic<uint8_t> middleIndex_;
+    uint8_t frontIndex_;
+};
+
+} // trafficsimulation::common
+
+#endif // TRIPLEBUFFER_HPP
@@ -0,0 +1,72 @@
+#ifndef OFFSCREENEXPORTER_HPP
+#define OFFSCREENEXPORTER_HPP
+
+#include <optional>
+#include <string>
+
+#include "../view/FrameExporter.hpp"
+
+namespace trafficsimulation::model{ class Simulation; }
+
+namespace trafficsimulation::controller
+{
+
+/*!
+ * \brief The ExportSettings struct
+ *
+ * Format and size of exported images. One image is exported every frameInterval ticks
+ * of simulation or every frameInterval frames of trajectory
+ */
+struct ExportSettings
+{
+    view::ExportFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint64_t frameInterval;
+};
+
+/*!
+ * \brief The OffscreenExporter class
+ *
+ * Renders simulation or recorded trajectory into images without any window and writes
+ * them with view::FrameExporter. Frames are rendered on calling thread while previous
+ * ones are encoded on encoder thread, nothing waits for refresh timer, so export runs as
+ * fast as rendering allows.
+ */
+class OffscreenExporter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param ExportSettings settings
+     */
+    explicit OffscreenExporter(const ExportSettings settings);
+    ~OffscreenExporter();
+
+    /*!
+     * \brief exportTrajectory
+     * \param std::string trajectoryPath - file written by TrajectoryRecorder
+     * \param std::string outputPath
+     * \return if trajectory could not be read or output written returns error message
+     */
+    std::optional<std::string> exportTrajectory(const std::string& trajectoryPath,
+        const std::string& outputPath) const;
+    /*!
+     * \brief exportSimulation
+     * \param model::Simulation simulation - simulation that is not running
+     * \param uint64_t ticks
+     * \param std::string outputPath
+     * \return if simulation could not be run or output written returns error message
+     *
+     * Runs simulation for given number of ticks and exports its current frame first
+     */
+    std::optional<std::string> exportSimulation(model::Simulation& simulation,
+        const uint64_t ticks, const std::string& outputPath) const;
+
+private:
+    const ExportSettings settings_;
+};
+
+} // trafficsimulation::controller
+
+#endif // OFFSCREENEXPORTER_HPP
@@ -5,8 +5,14 @@
 #include <memory>
 #include <vector>
 
+#include "../common/Point.hpp"
+
 namespace trafficsimulation{ class MainWindow; }
-namespace trafficsimulation::model{ class Simulation; }
+namespace trafficsimulation::model
+{
+class Simulation;
+class TrajectoryReplay;
+}
 namespace trafficsimulation::view::dialogs{ struct NotConnectedJunction; }
 
 namespace trafficsimulation::controller
@@ -82,13 +88,14 @@ public:
      * \brief startSimulation
      * \return true if simulation started succesfuly
      *
-     * Starts simulations, shows MessageBox if start failed. Sets possible destinations
+     * Starts simulations, shows MessageBox if start failed. Sets possible destinations.
+     * If recording is enabled asks for file that trajectory will be written to
      */
     bool startSimulation();
     /*!
      * \brief stopSimulation
      *
-     * Stops simulation
+     * Stops simulation and its recording
      */
     void stopSimulation();
     /*!
@@ -103,13 +110,80 @@ public:
      */
     void resetSimulation();
 
+    /*!
+     * \brief saveCheckpoint
+     * \return false if running simulation could not be started again after checkpoint
+     *
+     * Asks for file and writes full state of simulation to it. Running simulation is
+     * stopped for that time. Shows MessageBox if file could not be written or simulation
+     * could not be started again
+     */
+    bool saveCheckpoint();
+    /*!
+     * \brief loadCheckpoint
+     * \return true if checkpoint was loaded succesfuly
+     *
+     * Asks for checkpoint file, resets simulation and recreates junctions, paths,
+     * drivers and pedestrians with their painters, then restores their state.
+     * Shows MessageBox if checkpoint could not be loaded
+     */
+    bool loadCheckpoint();
+
+    /*!
+     * \brief loadReplay
+     * \return true if replay was loaded succesfuly
+     *
+     * Asks for trajectory file, resets simulation and paints layout of recording.
+     * Shows MessageBox if file could not be loaded
+     */
+    bool loadReplay();
+    /*!
+     * \brief toggleReplay
+     * \return true if replay is playing after the call
+     *
+     * Plays replay if it is paused, pauses it otherwise
+     */
+    bool toggleReplay();
+    /*!
+     * \brief seekReplay
+     * \param uint64_t frame
+     *
+     * Shows given frame of replay
+     */
+    void seekReplay(const uint64_t frame);
+    /*!
+     * \brief setReplaySpeed
+     * \param float speed
+     *
+     * Sets how many recorded ticks are played on each refresh
+     */
+    void setReplaySpeed(const float speed);
+
+    /*!
+     * \brief setVisibleArea
+     * \param common::Point topLeft
+     * \param common::Point bottomRight
+     *
+     * Sets part of scene shown by view, agents outside of it are not positioned by
+     * simulation. Area is kept for simulations created later
+     */
+    void setVisibleArea(const common::Point topLeft, const common::Point bottomRight);
+
 private:
+    /*!
+     * \brief resetSimulation
+     * \param uint64_t seed
+     *
+     * Resets view, deletes current simulation and creates new one with given seed
+     */
+    void resetSimulation(const uint64_t seed);
     /*!
      * \brief createSimulation
+     * \param uint64_t seed
      *
-     * Creates new simulation
+     * Creates new simulation with given seed
      */
-    void createSimulation();
+    void createSimulation(const uint64_t seed);
     /*!
      * \brief findNotConnectedJunctions
      * \param std::map<uint32_t, std::vector<uint32_t>> connectedJunctions
@@ -122,6 +196,9 @@ private:
 
     MainWindow* mainWindow_;
     std::unique_ptr<model::Simulation> simulation_;
+    std::unique_ptr<model::TrajectoryReplay> replay_;
+    common::Point visibleTopLeft_;
+    common::Point visibleBottomRight_;
 };
 
 } // trafficsimulation::controller
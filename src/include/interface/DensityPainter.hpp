@@ -0,0 +1,41 @@
+#ifndef DENSITYPAINTER_HPP
+#define DENSITYPAINTER_HPP
+
+#include <vector>
+
+#include "../common/Frame.hpp"
+
+namespace trafficsimulation::interface
+{
+
+/*!
+ * \brief The DensityPainter abstract class
+ *
+ * Has minimal interface that is required by model classes to paint load of roads
+ */
+class DensityPainter
+{
+public:
+    virtual ~DensityPainter() = default;
+
+    /*!
+     * \brief setRoadLoads
+     * \param std::vector<common::RoadLoad> roadLoads
+     *
+     * Pure virtual function. Sets loads of roads that will be printed
+     */
+    virtual void setRoadLoads(const std::vector<common::RoadLoad>& roadLoads) = 0;
+    /*!
+     * \brief paint
+     *
+     * Pure virtual function. Paints loads of roads
+     */
+    virtual void paint() = 0;
+
+protected:
+    DensityPainter() = default;
+};
+
+} // trafficsimulation::interface
+
+#endif // DENSITYPAINTER_HPP
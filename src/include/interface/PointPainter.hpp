@@ -29,6 +29,13 @@ public:
      * Pure virtual function. Paints point
      */
     virtual void paint() = 0;
+    /*!
+     * \brief release
+     *
+     * Called when painted object was removed from model, painter is not used after it.
+     * Does nothing by default
+     */
+    virtual void release() {}
 
 protected:
     PointPainter() = default;
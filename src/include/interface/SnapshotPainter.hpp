@@ -0,0 +1,42 @@
+#ifndef SNAPSHOTPAINTER_HPP
+#define SNAPSHOTPAINTER_HPP
+
+#include "../common/Frame.hpp"
+
+namespace trafficsimulation::interface
+{
+
+/*!
+ * \brief The SnapshotPainter abstract class
+ *
+ * Has minimal interface that is required by model classes to paint whole frames of
+ * simulation that runs without view
+ */
+class SnapshotPainter
+{
+public:
+    virtual ~SnapshotPainter() = default;
+
+    /*!
+     * \brief setLayout
+     * \param common::Layout layout
+     *
+     * Pure virtual function. Sets junctions, roads and pavements painted below every frame,
+     * it is called before first paint()
+     */
+    virtual void setLayout(const common::Layout& layout) = 0;
+    /*!
+     * \brief paint
+     * \param common::Frame frame
+     *
+     * Pure virtual function. Paints positions of drivers and pedestrians of frame
+     */
+    virtual void paint(const common::Frame& frame) = 0;
+
+protected:
+    SnapshotPainter() = default;
+};
+
+} // trafficsimulation::interface
+
+#endif // SNAPSHOTPAINTER_HPP
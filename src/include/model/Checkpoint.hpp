@@ -0,0 +1,166 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../common/Point.hpp"
+#include "Demand.hpp"
+#include "Junction.hpp"
+#include "RoadCondition.hpp"
+
+namespace trafficsimulation::model
+{
+
+constexpr auto CHECKPOINTFILEMAGIC = uint32_t{0x50435354}; /* "TSCP" */
+constexpr auto CHECKPOINTFILEVERSION = uint32_t{11};
+constexpr auto NO_VEHICLE = int32_t{-1};
+constexpr auto NO_ROAD = uint32_t{0x0000};
+
+/*!
+ * \brief The JunctionState struct
+ *
+ * Position and light state machine of Junction
+ */
+struct JunctionState
+{
+    uint32_t junctionId;
+    common::Point position;
+    LightState lightState;
+    uint32_t roadWithGreenIterator;
+    uint32_t timeoutTicks;
+    uint64_t lightStartTick;
+    uint64_t lightChangeTick;
+};
+
+/*!
+ * \brief The PathType enum
+ */
+enum class PathType : uint32_t
+{
+    Road,
+    Pavement
+};
+
+/*!
+ * \brief The PathState struct
+ *
+ * Values needed to recreate Road or Pavement between two junctions.
+ * roadCondition, speedLimit and laneCount are used only by roads
+ */
+struct PathState
+{
+    uint32_t pathId;
+    PathType pathType;
+    uint32_t startJunctionId;
+    uint32_t endJunctionId;
+    uint32_t length;
+    RoadCondition roadCondition;
+    uint32_t speedLimit;
+    uint32_t laneCount;
+};
+
+/*!
+ * \brief The DriverState struct
+ *
+ * Parameters of Driver and its Vehicle and their current state.
+ * If driver is crossing junction, roadId is id of road it goes to and previousRoadId is
+ * id of road it came from, otherwise previousRoadId is NO_ROAD. nextRoadId is id of road
+ * driver takes at the end of its road or NO_ROAD if it was not chosen yet.
+ * vehicleAhead and vehicleBehind are indexes of drivers in the same lane or NO_VEHICLE,
+ * isLastOnRoad is set for last vehicle of each lane. ticksOnRoad is time spent on road
+ * used for travel statistics of road.
+ * asleep is set if driver waits in queue before red light since asleepSinceTick
+ */
+struct DriverState
+{
+    uint32_t objectId;
+    uint64_t randomCounter;
+    uint32_t maxAcceleration;
+    uint32_t maxDeceleration;
+    float accelerationRate;
+    uint32_t minDistanceToVehicleAhead;
+    uint32_t maxSpeedOverLimit;
+    float roadConditionSpeedModifier;
+
+    uint32_t roadId;
+    uint32_t previousRoadId;
+    uint32_t nextRoadId;
+    common::Point position;
+    uint32_t destinationId;
+    bool despawnOnArrival;
+    uint32_t distanceTravelled;
+    uint32_t ticksOnRoad;
+    uint32_t speed;
+    int32_t vehicleAhead;
+    int32_t vehicleBehind;
+    uint32_t lane;
+    bool isLastOnRoad;
+    bool asleep;
+    uint64_t asleepSinceTick;
+};
+
+/*!
+ * \brief The PedestrianState struct
+ *
+ * Parameters of Pedestrian and its current state.
+ * If pedestrian is crossing junction, pavementId is id of pavement it goes to and
+ * temporaryStartPoint is start of temporary pavement it walks on
+ */
+struct PedestrianState
+{
+    uint32_t objectId;
+    uint64_t randomCounter;
+    uint32_t maxSpeed;
+    uint32_t pavementId;
+    bool onTemporaryPavement;
+    common::Point temporaryStartPoint;
+    common::Point position;
+    uint32_t destinationId;
+    bool despawnOnArrival;
+    uint32_t distanceTravelled;
+};
+
+/*!
+ * \brief The Checkpoint struct
+ *
+ * Full state of simulation. Junctions and paths are stored in order of their ids, so
+ * adding them in this order to new Simulation created with the same seed recreates the
+ * same ids and random streams. Drivers and pedestrians store all their parameters, so
+ * they can be restored to any simulation with the same number of them.
+ * waitingDrivers are numbers of drivers of each driver flow of demand that wait for space
+ * at their origin
+ */
+struct Checkpoint
+{
+    uint64_t seed;
+    uint64_t randomCounter;
+    uint64_t tick;
+    std::vector<JunctionState> junctions;
+    std::vector<PathState> paths;
+    std::vector<DriverState> drivers;
+    std::vector<PedestrianState> pedestrians;
+    Demand demand;
+    std::vector<uint32_t> waitingDrivers;
+};
+
+/*!
+ * \brief writeCheckpoint
+ * \param std::string filePath
+ * \param Checkpoint checkpoint
+ * \return if file could not be written returns error message
+ */
+std::optional<std::string> writeCheckpoint(const std::string& filePath,
+    const Checkpoint& checkpoint);
+/*!
+ * \brief readCheckpoint
+ * \param std::string filePath
+ * \param Checkpoint& checkpoint
+ * \return if file could not be read returns error message
+ */
+std::optional<std::string> readCheckpoint(const std::string& filePath, Checkpoint& checkpoint);
+
+} // trafficsimulation::model
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,54 @@
+#ifndef DEMAND_HPP
+#define DEMAND_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "DriverDistribution.hpp"
+
+namespace trafficsimulation::model
+{
+
+/*!
+ * \brief The DemandRate struct
+ *
+ * Mean number of agents spawned each tick starting from startTick, it holds until
+ * startTick of next rate
+ */
+struct DemandRate
+{
+    uint64_t startTick;
+    float agentsPerTick;
+};
+
+/*!
+ * \brief The DemandFlow struct
+ *
+ * One entry of origin-destination matrix. Agents of flow are spawned at junction of
+ * id == originId, go by fastest route to junction of id == destinationId and are
+ * removed from simulation when they reach it. Rates have to be sorted by startTick
+ */
+struct DemandFlow
+{
+    uint32_t originId;
+    uint32_t destinationId;
+    std::vector<DemandRate> rates;
+};
+
+/*!
+ * \brief The Demand struct
+ *
+ * Origin-destination matrix of drivers and pedestrians and distributions of parameters
+ * of spawned agents
+ */
+struct Demand
+{
+    std::vector<DemandFlow> driverFlows;
+    std::vector<DemandFlow> pedestrianFlows;
+    DriverDistribution driverDistribution;
+    Range<uint32_t> pedestrianMaxSpeed;
+};
+
+} // trafficsimulation::model
+
+#endif // DEMAND_HPP
@@ -2,6 +2,7 @@
 #define DRIVER_HPP
 
 #include <memory>
+#include <utility>
 
 #include "MovingObject.hpp"
 
@@ -10,6 +11,7 @@ namespace trafficsimulation::model
 
 class Road;
 class Vehicle;
+struct DriverState;
 
 /*!
  * \brief The Driver class
@@ -23,6 +25,8 @@ class Driver : public MovingObject
 public:
     /*!
      * \brief Constructor
+     * \param uint32_t driverId
+     * \param uint64_t seed
      * \param std::shared_ptr<Road> road
      * \param std::unique_ptr<Vehicle> vehicle
      * \param float accelerationRate
@@ -30,25 +34,133 @@ public:
      * \param uint32_t maxSpeedOverLimit
      * \param float roadConditionSpeedModifier
      */
-    Driver(const std::shared_ptr<Road> road, std::unique_ptr<Vehicle> vehicle,
-        const float accelerationRate, const uint32_t minDistanceToVehicleAhead,
-        const uint32_t maxSpeedOverLimit, const float roadConditionSpeedModifier);
+    Driver(const uint32_t driverId, const uint64_t seed, const std::shared_ptr<Road> road,
+        std::unique_ptr<Vehicle> vehicle, const float accelerationRate,
+        const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
+        const float roadConditionSpeedModifier);
     virtual ~Driver();
 
+    /*!
+     * \brief respawn
+     * \param uint32_t driverId
+     * \param std::shared_ptr<Road> road
+     * \param std::unique_ptr<Vehicle> vehicle
+     * \param float accelerationRate
+     * \param uint32_t minDistanceToVehicleAhead
+     * \param uint32_t maxSpeedOverLimit
+     * \param float roadConditionSpeedModifier
+     *
+     * Reinitializes driver that was released by simulation as if it was newly constructed
+     */
+    void respawn(const uint32_t driverId, const std::shared_ptr<Road> road,
+        std::unique_ptr<Vehicle> vehicle, const float accelerationRate,
+        const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
+        const float roadConditionSpeedModifier);
+    /*!
+     * \brief releaseVehicle
+     * \return vehicle of driver
+     *
+     * Used when driver is removed from simulation, so its vehicle can be reused
+     */
+    std::unique_ptr<Vehicle> releaseVehicle();
+
+    std::shared_ptr<Road> getRoad() const;
+    Vehicle* getVehicle() const;
+    /*!
+     * \brief getState
+     * \return parameters of driver and vehicle and their current state
+     *
+     * Fields describing road and other vehicles are not set, they are filled by Simulation
+     */
+    DriverState getState() const;
+    /*!
+     * \brief restoreState
+     * \param DriverState state
+     * \param std::shared_ptr<Road> road
+     *
+     * Puts driver on road and restores its parameters, position and speed, so state can
+     * be restored to any driver. Vehicles ahead and behind are set by Simulation
+     */
+    void restoreState(const DriverState& state, const std::shared_ptr<Road> road);
+    /*!
+     * \brief canSleep
+     * \return true if driver stands at the end of road with red light or stands in
+     * queue behind sleeping vehicle
+     *
+     * Such driver does not change its state until light of its road turns green, so it
+     * does not have to be updated
+     */
+    bool canSleep() const;
+    /*!
+     * \brief sleep
+     * \param uint64_t tick - first tick in which driver is not updated
+     */
+    void sleep(const uint64_t tick);
+    /*!
+     * \brief wake
+     * \param uint64_t tick - first tick in which driver is updated again
+     *
+     * Adds ticks spent asleep to time spent on road
+     */
+    void wake(const uint64_t tick);
+    /*!
+     * \brief updatePosition
+     *
+     * Calculates position_ again, called for sleeping driver when visibility of road_
+     * changes
+     */
+    void updatePosition();
+
 private:
     /*!
      * \brief move
      *
      * Overrides MovingObject::move()
-     * Calculates distanceTravelled_ and position_
+     * Calculates distanceTravelled_ and position_, position_ only if road_ is visible
      */
     void move() override;
+    /*!
+     * \brief changeLane
+     *
+     * On road with many lanes overtakes slower vehicle ahead using lane on the left or
+     * goes back to lane on the right when it is free, only if canChangeLane()
+     */
+    void changeLane();
+    /*!
+     * \brief canChangeLane
+     * \param uint32_t lane
+     * \return true if neither driver nor vehicle behind it in lane would have to brake
+     * harder than when following vehicle ahead
+     */
+    bool canChangeLane(const uint32_t lane) const;
     /*!
      * \brief calculateNewSpeed
      *
-     * Calculates new speed of driver considering his distance to closes object in front
+     * Calculates new speed of driver considering his distance to closes object in front.
+     * If there is no vehicle ahead on road_ and driver approaches green light it also
+     * follows last vehicle on path it takes behind junction
      */
     void calculateNewSpeed();
+    /*!
+     * \brief approachJunction
+     *
+     * Calculates new speed using distance to junction and its light
+     */
+    void approachJunction();
+    /*!
+     * \brief followVehicle
+     * \param Vehicle* vehicleAhead
+     * \param uint32_t distanceToVehicle
+     *
+     * Calculates new speed using distance to vehicleAhead and its speed
+     */
+    void followVehicle(const Vehicle* const vehicleAhead, const uint32_t distanceToVehicle);
+    /*!
+     * \brief findVehicleBeyondJunction
+     * \return last vehicle on junction road or on next road that driver enters and its
+     * distance from driver, nullptr if both are empty
+     */
+    std::pair<const Vehicle*, uint32_t> findVehicleBeyondJunction();
     /*!
      * \brief accelerate
      *
@@ -74,17 +186,29 @@ private:
     /*!
      * \brief selectNewPath
      *
-     * Randomly selects Road from outgoing roads from Juction that is at the end of
-     * road_ or if destination is set selects fastest route
+     * Records passage through road_, then enters road returned by getNextRoad().
+     * If destination was reached and driver despawns on arrival marks it as arrived
      */
     void selectNewPath();
+    /*!
+     * \brief getNextRoad
+     * \return road driver takes at the end of road_, nullptr if driver despawns there
+     *
+     * Road is chosen once per road_, when driver first looks beyond junction or reaches
+     * it. Randomly selects Road from outgoing roads from Junction that is at the end of
+     * road_ or if destination is set selects fastest route
+     */
+    std::shared_ptr<Road> getNextRoad();
 
     std::shared_ptr<Road> road_;
-    const std::unique_ptr<Vehicle> vehicle_;
-    const float accelerationRate_; /* 0.2 - 1 */
-    const uint32_t minDistanceToVehicleAhead_; /* 1000 - 8000 */
-    const uint32_t maxSpeedOverLimit_; /* 0 - 30 */
-    const float roadConditionSpeedModifier_;
+    std::shared_ptr<Road> nextRoad_;
+    uint32_t ticksOnRoad_;
+    uint64_t asleepSinceTick_;
+    std::unique_ptr<Vehicle> vehicle_;
+    float accelerationRate_; /* 0.2 - 1 */
+    uint32_t minDistanceToVehicleAhead_; /* 1000 - 8000 */
+    uint32_t maxSpeedOverLimit_; /* 0 - 30 */
+    float roadConditionSpeedModifier_;
 };
 
 } // trafficsimulation::model
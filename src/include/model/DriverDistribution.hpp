@@ -0,0 +1,40 @@
+#ifndef DRIVERDISTRIBUTION_HPP
+#define DRIVERDISTRIBUTION_HPP
+
+#include <cstdint>
+
+namespace trafficsimulation::model
+{
+
+/*!
+ * \brief The Range struct
+ * Lowest and highest (inclusive) value that can be generated
+ */
+template<typename T>
+struct Range
+{
+    T min;
+    T max;
+};
+
+/*!
+ * \brief The DriverDistribution struct
+ *
+ * Ranges of parameters of randomly generated drivers and their vehicles
+ */
+struct DriverDistribution
+{
+    Range<uint32_t> maxAcceleration;
+    Range<uint32_t> maxDeceleration;
+    Range<float> accelerationRate;
+    Range<uint32_t> minDistanceToVehicleAhead;
+    Range<uint32_t> maxSpeedOverLimit;
+    Range<float> roadConditionSpeedModifier;
+};
+
+constexpr auto DEFAULTDRIVERDISTRIBUTION = DriverDistribution{{5, 8}, {10, 24},
+    {float{0.2}, float{1}}, {1000, 9000}, {0, 300}, {float{0}, float{0.15}}};
+
+} // trafficsimulation::model
+
+#endif // DRIVERDISTRIBUTION_HPP
@@ -0,0 +1,128 @@
+#ifndef ENSEMBLERUNNER_HPP
+#define ENSEMBLERUNNER_HPP
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../interface/SnapshotPainter.hpp"
+#include "Demand.hpp"
+#include "DriverDistribution.hpp"
+#include "Network.hpp"
+#include "Road.hpp"
+#include "SignalController.hpp"
+
+namespace trafficsimulation::model
+{
+
+class Simulation;
+
+/*!
+ * \brief The EnsembleMember struct
+ *
+ * Parameters of one simulation of ensemble. driverCount drivers and pedestrianCount
+ * pedestrians are spawned at start, agents of demand are spawned during simulation.
+ * If signalController is not set junctions use fixed time lights. Lights of junctions of
+ * each corridor, given as ids of junctions in driving order, are coordinated into green
+ * wave, see Simulation::coordinateCorridor(). If snapshotPainter is set it gets layout
+ * of simulation and frame at start and after every snapshotInterval ticks (0 is treated
+ * as 1), it is called from worker thread, so each member needs its own painter
+ */
+struct EnsembleMember
+{
+    uint64_t seed;
+    uint32_t driverCount;
+    uint32_t pedestrianCount;
+    DriverDistribution driverDistribution;
+    Demand demand;
+    std::shared_ptr<const SignalController> signalController;
+    std::vector<std::vector<uint32_t>> corridors;
+    std::shared_ptr<interface::SnapshotPainter> snapshotPainter = nullptr;
+    uint64_t snapshotInterval = 1;
+};
+
+/*!
+ * \brief The EnsembleResult struct
+ *
+ * Statistics of roads after one simulation of ensemble, if simulation could not be run
+ * error is set and roadStatistics is empty
+ */
+struct EnsembleResult
+{
+    uint64_t seed;
+    std::optional<std::string> error;
+    std::map<uint32_t /* roadId */, RoadStatistics> roadStatistics;
+};
+
+/*!
+ * \brief The EnsembleStatistics struct
+ *
+ * Results of all simulations and statistics aggregated over simulations that succeeded:
+ *  - meanTravelTicks - mean number of ticks vehicle needed to drive through road
+ *  - meanThroughput - mean number of vehicles that drove through road in one simulation
+ */
+struct EnsembleStatistics
+{
+    std::vector<EnsembleResult> results;
+    double meanTravelTicks;
+    std::map<uint32_t /* roadId */, double> meanThroughput;
+};
+
+/*!
+ * \brief The EnsembleRunner class
+ *
+ * Runs many independent simulations of one network on all cores. Every simulation is
+ * created from the same read-only Network, so fastest routes are calculated and stored
+ * only once. Simulations run on plain threads and create no Qt objects, agents and network
+ * are not painted unless member has snapshot painter.
+ */
+class EnsembleRunner
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param std::shared_ptr<const Network> network
+     */
+    explicit EnsembleRunner(const std::shared_ptr<const Network> network);
+    ~EnsembleRunner();
+
+    /*!
+     * \brief run
+     * \param std::vector<EnsembleMember> members
+     * \param uint64_t ticks
+     * \param uint32_t threadCount - if 0 number of hardware threads is used
+     * \return statistics of all simulations
+     *
+     * Runs each member for given number of ticks, blocks until all of them finish
+     */
+    EnsembleStatistics run(const std::vector<EnsembleMember>& members, const uint64_t ticks,
+        const uint32_t threadCount) const;
+
+private:
+    /*!
+     * \brief runMember
+     * \param EnsembleMember member
+     * \param uint64_t ticks
+     * \return statistics of roads after simulation of member
+     */
+    EnsembleResult runMember(const EnsembleMember& member, const uint64_t ticks) const;
+    /*!
+     * \brief runWithSnapshots
+     * \param Simulation simulation
+     * \param EnsembleMember member - member with snapshot painter
+     * \param uint64_t ticks
+     * \return if simulation could not be run returns error message
+     *
+     * Runs simulation in steps of snapshotInterval ticks and paints frame after each step
+     */
+    std::optional<std::string> runWithSnapshots(Simulation& simulation,
+        const EnsembleMember& member, const uint64_t ticks) const;
+
+    const std::shared_ptr<const Network> network_;
+};
+
+} // trafficsimulation::model
+
+#endif // ENSEMBLERUNNER_HPP
@@ -17,9 +17,31 @@ namespace trafficsimulation::model
 {
 
 constexpr auto JUNCTIONRADIUS = uint32_t{20};
+/* id of temporary junctions and paths used to cross junction */
+constexpr auto DUMMY_ID = uint32_t{0xFFFF};
+/* temporary junctions have no incoming roads, so their lights are never used */
+constexpr auto DUMMY_SEED = uint64_t{0};
+constexpr auto DUMMY_TICK = uint64_t{0};
+/* light slot of pavements and other paths that are not incoming roads of junction */
+constexpr auto OTHER_PATHS_LIGHT_SLOT = uint32_t{0};
 
 class Path;
 class Road;
+class SignalController;
+struct JunctionState;
+
+/*!
+ * \brief The Route struct
+ *
+ * Ids of first road and first pavement of fastest route to destination
+ */
+struct Route
+{
+    uint32_t roadId;
+    uint32_t pavementId;
+};
+/* fastest routes from junction, key is id of destination junction */
+using Routes = std::map<uint32_t, Route>;
 
 /*!
  * \brief The LightState enum
@@ -47,35 +69,64 @@ public:
      * Constructor
      * \param uint32_t junctionId
      * \param common::Point position
+     * \param uint64_t seed
+     * \param uint64_t tick - first tick in which junction is updated
      *
-     * Randomly generates value of timeoutTicks_.
+     * Randomly generates value of timeoutTicks_ from generator keyed by seed and junctionId.
+     * First light change is scheduled relative to tick, so junction added to running
+     * simulation starts its lights from the beginning
      */
-    Junction(const uint32_t junctionId, const common::Point position);
+    Junction(const uint32_t junctionId, const common::Point position, const uint64_t seed,
+        const uint64_t tick);
     ~Junction();
 
     uint32_t getId() const;
     common::Point getPosition() const;
     uint32_t getSpeedLimit() const;
+    /*!
+     * \brief getLightChangeTick
+     * \return tick of simulation in which lights change next time
+     */
+    uint64_t getLightChangeTick() const;
+    /*!
+     * \brief getCycleTicks
+     * \return number of ticks after which each incoming road gets green light again,
+     * holds for fixed time lights
+     */
+    uint32_t getCycleTicks() const;
+    uint32_t getIncomingRoadCount() const;
     /*!
      * \brief isGreenLight
-     * \param uint32_t pathId
-     * \return true if path with given pathId has green light
+     * \param uint32_t lightSlot - light slot of path, see Path::hasGreenLight()
+     * \return true if path with given lightSlot has green light
      *
      * When pedestrian light is on pedestrians from all paths can cross the junction but
      * drivers can only do so from road that currently has green light
      */
-    bool isGreenLight(const uint32_t pathId) const;
+    bool isGreenLight(const uint32_t lightSlot) const;
     std::vector<std::weak_ptr<Road>> getOutgoingRoads() const;
     std::vector<std::weak_ptr<Path>> getOutgoingPavements() const;
+    /*!
+     * \brief getFastestRoad
+     * \param uint32_t destinationId
+     * \return first road of fastest route to destination or nullptr if destination cannot
+     * be reached from junction
+     */
     std::shared_ptr<Road> getFastestRoad(const uint32_t destinationId);
+    /*!
+     * \brief getFastestPavement
+     * \param uint32_t destinationId
+     * \return first pavement of fastest route to destination or nullptr if destination cannot
+     * be reached from junction
+     */
     std::shared_ptr<Path> getFastestPavement(const uint32_t destinationId);
 
     /*!
      * \brief addIncomingRoad
      * \param std::shared_ptr<Road> newRoad
      *
-     * Adds road to incomingRoads_ and creates new junction road for each outgoingRoads_
-     * creating connection between them
+     * Adds road to incomingRoads_, assigns it light slot and creates new junction road
+     * for each outgoingRoads_ creating connection between them
      */
     void addIncomingRoad(const std::shared_ptr<Road> newRoad);
     /*!
@@ -94,14 +145,34 @@ public:
      */
     void addOutgoingPavement(const std::shared_ptr<Path> newPavement);
     /*!
-     * \brief setFastestRoute
-     * \param uint32_t destinationId
-     * \param std::pair<std::weak_ptr<Road>, std::weak_ptr<Path>> bestPaths
+     * \brief setFastestRoutes
+     * \param std::shared_ptr<const Routes> fastestRoutes
      *
-     * Sets fastest route to junction of id == destinationId
+     * Sets fastest routes to other junctions. Routes store only ids of paths, so the same
+     * routes can be shared by junctions of many simulations of one network
      */
-    void setFastestRoute(const uint32_t destinationId,
-        const std::pair<std::weak_ptr<Road>, std::weak_ptr<Path>> bestPaths);
+    void setFastestRoutes(const std::shared_ptr<const Routes> fastestRoutes);
+    /*!
+     * \brief setSignalController
+     * \param std::shared_ptr<const SignalController> signalController
+     *
+     * Sets strategy that decides order and duration of green lights, by default
+     * FIXEDTIMESIGNALCONTROLLER is used
+     */
+    void setSignalController(const std::shared_ptr<const SignalController> signalController);
+    /*!
+     * \brief coordinateLights
+     * \param uint32_t cycleTicks - has to be divisible by 2 * number of incoming roads
+     * \param uint32_t roadId - id of incoming road
+     * \param uint64_t greenStartTick - tick in which road of roadId gets green light
+     * \param uint64_t tick - first tick of simulation that was not run yet
+     *
+     * Changes timeoutTicks_ so getCycleTicks() returns cycleTicks and sets lights to
+     * state they would have in tick if road of roadId got green light in greenStartTick.
+     * Used to synchronize junctions of corridor, offsets hold for fixed time lights
+     */
+    void coordinateLights(const uint32_t cycleTicks, const uint32_t roadId,
+        const uint64_t greenStartTick, const uint64_t tick);
 
     /*!
      * \brief getJunctionRoad
@@ -110,6 +181,7 @@ public:
      * \return pointer to junction road which is stored at junctionRoads_[oldRoadId][newRoadId]
      */
     std::shared_ptr<Road> getJunctionRoad(const uint32_t oldRoadId, const uint32_t newRoadId) const;
+    const std::map<uint32_t, std::map<uint32_t, std::shared_ptr<Road>>>& getJunctionRoads() const;
     /*!
      * \brief createTemporaryPavement
      * \param common::Point startPoint
@@ -119,12 +191,25 @@ public:
     std::shared_ptr<Path> createTemporaryPavement(const common::Point startPoint,
         const std::shared_ptr<Path> newPavement) const;
 
+    /*!
+     * \brief getState
+     * \return position and state of lights
+     */
+    JunctionState getState() const;
+    /*!
+     * \brief restoreState
+     * \param JunctionState state
+     *
+     * Sets state of lights, used when simulation is restored from checkpoint
+     */
+    void restoreState(const JunctionState& state);
+
     void setPainter(interface::PointPainter* const painter);
     /*!
      * \brief update
      *
-     * Decreases ticksToLightChange_, if is 0 then changes lights.
-     * If painter is set paints object
+     * Called by simulation only in tick returned by getLightChangeTick(). Changes lights,
+     * junction is painted only when its painter is set
      */
     void update();
 
@@ -132,10 +217,22 @@ private:
     /*!
      * \brief changeLights
      *
-     * Changes light and sets ticksToLightChange_ to new value, behavior depends on
-     * which light is turned on
+     * Changes light and moves lightChangeTick_ by duration of new light, behavior depends
+     * on which light is turned on. Road with green light and its duration are chosen by
+     * signalController_, which can also extend green light instead of ending it
      */
     void changeLights();
+    /*!
+     * \brief getQueueLengths
+     * \return number of vehicles on each of incomingRoads_
+     */
+    std::vector<uint32_t> getQueueLengths() const;
+    /*!
+     * \brief updateGreenLights
+     *
+     * Sets greenLights_ for current light, so isGreenLight() is a single load
+     */
+    void updateGreenLights();
 
     const uint32_t junctionId_;
     const common::Point position_;
@@ -144,13 +241,17 @@ private:
     LightState lightState_;
     uint32_t roadWithGreenIterator_;
     uint32_t timeoutTicks_;
-    uint32_t ticksToLightChange_;
+    uint64_t lightStartTick_;
+    uint64_t lightChangeTick_;
 
     std::vector<std::weak_ptr<Road>> incomingRoads_;
+    /* indexed by light slot, slot of incoming road is its index in incomingRoads_ + 1 */
+    std::vector<uint8_t> greenLights_;
     std::vector<std::weak_ptr<Road>> outgoingRoads_;
     std::vector<std::weak_ptr<Path>> outgoingPavements_;
     std::map<uint32_t, std::map<uint32_t, std::shared_ptr<Road>>> junctionRoads_;
-    std::map<uint32_t /* destinationId */, std::pair<std::weak_ptr<Road>, std::weak_ptr<Path>>> fastestRoutes_;
+    std::shared_ptr<const Routes> fastestRoutes_;
+    std::shared_ptr<const SignalController> signalController_;
 
     interface::PointPainter* painter_;
 };
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "../common/Point.hpp"
+#include "../common/RandomGenerator.hpp"
 
 namespace trafficsimulation::interface{ class PointPainter; }
 
@@ -23,20 +24,51 @@ class MovingObject
 public:
     virtual ~MovingObject();
 
+    uint32_t getId() const;
+    /*!
+     * \brief getPosition
+     * \return position of object, common::HIDDENPOINT if its path is not visible
+     */
+    common::Point getPosition() const;
     void setDestination(const uint32_t newDestinationId);
+    /*!
+     * \brief setDestination
+     * \param uint32_t newDestinationId
+     * \param bool despawnOnArrival
+     *
+     * If despawnOnArrival is true object stops moving when it reaches destination and
+     * is removed from simulation
+     */
+    void setDestination(const uint32_t newDestinationId, const bool despawnOnArrival);
+    bool hasArrived() const;
 
     void setPainter(interface::PointPainter* const painter);
     /*!
      * \brief update
      *
      * Calls move() function.
-     * If painter is set sets new position and paints object.
+     * If painter is set and object is not hidden sets new position and paints object.
      * Should be called on each takt of simulation
      */
     void update();
 
 protected:
-    MovingObject();
+    /*!
+     * \brief Constructor
+     * \param uint32_t objectId
+     * \param uint64_t seed
+     *
+     * Creates random_ generator keyed by seed and objectId
+     */
+    MovingObject(const uint32_t objectId, const uint64_t seed);
+    /*!
+     * \brief respawn
+     * \param uint32_t objectId
+     *
+     * Clears state and painter and starts new random_ stream keyed by objectId, used when
+     * object is recycled
+     */
+    void respawn(const uint32_t objectId);
 
     /*!
      * \brief move
@@ -45,9 +77,13 @@ protected:
      */
     virtual void move() = 0;
 
+    uint32_t objectId_;
     common::Point position_;
     uint32_t destinationId_;
     uint32_t distanceTravelled_;
+    bool despawnOnArrival_;
+    bool arrived_;
+    common::RandomGenerator random_;
 
 private:
     interface::PointPainter* painter_;
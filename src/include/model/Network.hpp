@@ -0,0 +1,32 @@
+#ifndef NETWORK_HPP
+#define NETWORK_HPP
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "../common/Point.hpp"
+#include "Checkpoint.hpp"
+#include "Junction.hpp"
+
+namespace trafficsimulation::model
+{
+
+/*!
+ * \brief The Network struct
+ *
+ * Read-only description of junctions, paths and fastest routes of simulation.
+ * Junctions are stored in order of their ids, first one is created by simulation itself.
+ * Routes are shared by all simulations created from network, so they are calculated
+ * and stored only once
+ */
+struct Network
+{
+    std::vector<common::Point> junctions;
+    std::vector<PathState> paths;
+    std::map<uint32_t /* junctionId */, std::shared_ptr<const Routes>> routes;
+};
+
+} // trafficsimulation::model
+
+#endif // NETWORK_HPP
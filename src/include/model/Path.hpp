@@ -35,7 +35,32 @@ public:
     uint32_t getPathId() const;
     uint32_t getLength() const;
     common::Point getStartPoint() const;
+    common::Point getEndPoint() const;
     std::shared_ptr<Junction> getJunction() const;
+    /*!
+     * \brief setLightSlot
+     * \param uint32_t lightSlot
+     *
+     * Set by end junction when path is its incoming road
+     */
+    void setLightSlot(const uint32_t lightSlot);
+    /*!
+     * \brief hasGreenLight
+     * \return true if end junction lets objects from path cross it
+     */
+    bool hasGreenLight() const;
+    /*!
+     * \brief setVisible
+     * \param bool visible
+     *
+     * Set by simulation when visible area changes, paths are visible by default
+     */
+    void setVisible(const bool visible);
+    /*!
+     * \brief isVisible
+     * \return true if objects on path have to calculate their position
+     */
+    bool isVisible() const;
 
     /*!
      * \brief calculateNewPosition
@@ -61,6 +86,8 @@ private:
     const common::Point endPoint_;
     const common::Point shiftOfStartPoint_;
     const std::shared_ptr<Junction> endJunction_;
+    uint32_t lightSlot_;
+    bool visible_;
 
     interface::LinePainter* painter_;
 };
@@ -10,6 +10,7 @@ namespace trafficsimulation::model
 {
 
 class Path;
+struct PedestrianState;
 
 /*!
  * \brief The Pedestrian class
@@ -22,18 +23,50 @@ class Pedestrian : public MovingObject
 public:
     /*!
      * \brief Constructor
+     * \param uint32_t pedestrianId
+     * \param uint64_t seed
      * \param std::shared_ptr<Path> pavement
      * \param uint32_t maxSpeed
      */
-    Pedestrian(const std::shared_ptr<Path> pavement, const uint32_t maxSpeed);
+    Pedestrian(const uint32_t pedestrianId, const uint64_t seed,
+        const std::shared_ptr<Path> pavement, const uint32_t maxSpeed);
     virtual ~Pedestrian();
 
+    /*!
+     * \brief respawn
+     * \param uint32_t pedestrianId
+     * \param std::shared_ptr<Path> pavement
+     * \param uint32_t maxSpeed
+     *
+     * Reinitializes pedestrian that was released by simulation as if it was newly
+     * constructed
+     */
+    void respawn(const uint32_t pedestrianId, const std::shared_ptr<Path> pavement,
+        const uint32_t maxSpeed);
+
+    std::shared_ptr<Path> getPavement() const;
+    /*!
+     * \brief getState
+     * \return parameters of pedestrian and its current state
+     *
+     * Fields describing pavement are not set, they are filled by Simulation
+     */
+    PedestrianState getState() const;
+    /*!
+     * \brief restoreState
+     * \param PedestrianState state
+     * \param std::shared_ptr<Path> pavement
+     *
+     * Puts pedestrian on pavement and restores its parameters and position
+     */
+    void restoreState(const PedestrianState& state, const std::shared_ptr<Path> pavement);
+
 private:
     /*!
      * \brief move
      *
      * Overrides MovingObject::move()
-     * Calculates distanceTravelled_ and position_
+     * Calculates distanceTravelled_ and position_, position_ only if pavement_ is visible
      */
     void move() override;
     /*!
@@ -48,12 +81,13 @@ private:
      * \brief selectNewPath
      *
      * Randomly selects Path from outgoing pavements from Juction that is at the end of
-     * pavement_ or if destination is set selects fastest route
+     * pavement_ or if destination is set selects fastest route.
+     * If destination was reached and pedestrian despawns on arrival marks it as arrived
      */
     void selectNewPath();
 
     std::shared_ptr<Path> pavement_;
-    const uint32_t maxSpeed_; /* 30 - 120 */
+    uint32_t maxSpeed_; /* 30 - 120 */
 };
 
 } // trafficsimulation::model
@@ -1,19 +1,36 @@
 #ifndef ROAD_HPP
 #define ROAD_HPP
 
+#include <utility>
+#include <vector>
+
 #include "Path.hpp"
 #include "RoadCondition.hpp"
+#include "VehicleQueue.hpp"
 
 namespace trafficsimulation::model
 {
 
 class Vehicle;
 
+/*!
+ * \brief The RoadStatistics struct
+ *
+ * Number of vehicles that drove through road and sum of ticks they spent on it
+ */
+struct RoadStatistics
+{
+    uint64_t passedVehicles;
+    uint64_t totalTravelTicks;
+};
+
 /*!
  * \brief The Road class
  *
  * Inherits and extends Path class.
- * Is more advanced path between Junction objects. Has speedLimit and condition properties
+ * Is more advanced path between Junction objects. Has speedLimit, condition and lanes.
+ * Vehicles of each lane are stored in VehicleQueue sorted from first to last one and
+ * each of them is linked with vehicles ahead and behind in its lane.
  * Used by Driver and (by extention) Vehicle objects
  */
 class Road : public Path
@@ -28,35 +45,125 @@ public:
      * \param std::shared_ptr<Junction> endJunction
      * \param RoadCondition roadCondition
      * \param uint32_t speedLimit
+     * \param uint32_t laneCount
      */
     Road(const uint32_t pathId, const uint32_t length, const common::Point startPoint,
         const common::Point endPoint, const std::shared_ptr<Junction> endJunction,
-        const RoadCondition roadCondition, const uint32_t speedLimit);
+        const RoadCondition roadCondition, const uint32_t speedLimit,
+        const uint32_t laneCount);
     ~Road();
 
     RoadCondition getRoadCondition() const;
     uint32_t getSpeedLimit() const;
+    uint32_t getLaneCount() const;
 
     /*!
      * \brief addVehicle
      * \param Vehicle* newLastVehicle
      *
      * Called when Vehicle object enters this Road.
-     * Informs newLastVehicle if there is a Vehicle in front of it on this Road
+     * Puts newLastVehicle at the end of lane returned by getEntryLane() and informs it
+     * if there is a Vehicle in front of it in this lane
      */
     void addVehicle(Vehicle* const newLastVehicle);
+    /*!
+     * \brief addVehicles
+     * \param std::vector<Vehicle*> newVehicles
+     *
+     * Called when many Vehicle objects enter this Road at once. Vehicles are spread over
+     * lanes in turn starting from getEntryLane(), sorted by lane and distance travelled,
+     * and appended to each lane in one pass, first of newVehicles enters first
+     */
+    void addVehicles(const std::vector<Vehicle*>& newVehicles);
     /*!
      * \brief removeVehicle
      * \param Vehicle* removedVehicle
      *
-     * Called when Vehicle object leaves this Road.
+     * Called when Vehicle object leaves this Road. Links vehicles that were ahead and
+     * behind of removedVehicle with each other, marks sleeping queue as changed if vehicle
+     * behind was asleep
      */
     void removeVehicle(Vehicle* const removedVehicle);
+    /*!
+     * \brief changeLane
+     * \param Vehicle* vehicle
+     * \param uint32_t lane
+     *
+     * Moves vehicle to its place in lane, vehicles in lane are ordered by distance they
+     * travelled. Links vehicle with its new neighbours, marks sleeping queue as changed if
+     * sleeping vehicle got new vehicle ahead
+     */
+    void changeLane(Vehicle* const vehicle, const uint32_t lane);
+    /*!
+     * \brief getNeighbours
+     * \param uint32_t lane
+     * \param uint32_t distanceTravelled
+     * \return vehicles of lane that would be ahead and behind of vehicle that travelled
+     * distanceTravelled on road, nullptr if there is no such vehicle
+     */
+    std::pair<Vehicle* /* vehicleAhead */, Vehicle* /* vehicleBehind */> getNeighbours(
+        const uint32_t lane, const uint32_t distanceTravelled) const;
+
+    /*!
+     * \brief getEntryLane
+     * \return lane with the most free space at its start, new vehicles enter it
+     */
+    uint32_t getEntryLane() const;
+    /*!
+     * \brief getLastVehicle
+     * \param uint32_t lane
+     * \return last vehicle of lane, nullptr if lane is empty
+     */
+    Vehicle* getLastVehicle(const uint32_t lane) const;
+    /*!
+     * \brief getVehicleCount
+     * \return number of vehicles on all lanes of road
+     */
+    uint32_t getVehicleCount() const;
+    /*!
+     * \brief getOccupancy
+     * \return part of lanes that vehicles would take standing in jam, 1 for jammed road
+     */
+    float getOccupancy() const;
+    /*!
+     * \brief clearVehicles
+     *
+     * Empties lanes without informing vehicles, used when simulation is restored
+     * from checkpoint
+     */
+    void clearVehicles();
+    /*!
+     * \brief restoreLane
+     * \param uint32_t lane
+     * \param std::vector<Vehicle*> vehicles - vehicles of lane from first to last one
+     *
+     * Sets vehicles of lane and links them, used when simulation is restored
+     * from checkpoint
+     */
+    void restoreLane(const uint32_t lane, const std::vector<Vehicle*>& vehicles);
+
+    /*!
+     * \brief recordPassage
+     * \param uint32_t travelTicks
+     *
+     * Called when vehicle leaves road after spending travelTicks on it
+     */
+    void recordPassage(const uint32_t travelTicks);
+    /*!
+     * \brief takeSleepingQueueChange
+     * \return true if sleeping vehicle got new vehicle ahead since last call, sleeping
+     * vehicles of road have to be woken then
+     */
+    bool takeSleepingQueueChange();
+    RoadStatistics getStatistics() const;
 
 private:
     const RoadCondition roadCondition_;
     const uint32_t speedLimit_;
-    Vehicle* lastVehicle_;
+    /* vehicles of each lane from first to last one */
+    std::vector<VehicleQueue> lanes_;
+    RoadStatistics statistics_;
+    bool sleepingQueueChanged_;
 };
 
 } // trafficsimulation::model
@@ -0,0 +1,137 @@
+#ifndef SIGNALCONTROLLER_HPP
+#define SIGNALCONTROLLER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace trafficsimulation::model
+{
+
+/*!
+ * \brief The SignalPhase struct
+ *
+ * Index of incoming road of junction that gets green light and number of ticks it lasts
+ */
+struct SignalPhase
+{
+    uint32_t greenRoad;
+    uint32_t greenTicks;
+};
+
+/*!
+ * \brief The SignalController abstract class
+ *
+ * Strategy used by Junction to decide order and duration of green lights of its incoming
+ * roads. queueLengths holds number of vehicles on each incoming road, in order in which
+ * roads were added to junction. Controllers have no state, so one controller can be
+ * shared by all junctions and simulations.
+ */
+class SignalController
+{
+public:
+    virtual ~SignalController() = default;
+
+    /*!
+     * \brief selectPhase
+     * \param std::vector<uint32_t> queueLengths
+     * \param uint32_t lastGreenRoad - index of road that had green light last time
+     * \param uint32_t defaultGreenTicks - duration of green light of fixed cycle of junction
+     * \return road that gets green light and its duration
+     *
+     * Pure virtual function. Called when pedestrian red light ends
+     */
+    virtual SignalPhase selectPhase(const std::vector<uint32_t>& queueLengths,
+        const uint32_t lastGreenRoad, const uint32_t defaultGreenTicks) const = 0;
+    /*!
+     * \brief extendGreen
+     * \param std::vector<uint32_t> queueLengths
+     * \param uint32_t greenRoad
+     * \param uint32_t greenTicks - number of ticks green light already lasts
+     * \return number of ticks by which green light is extended, 0 ends it
+     *
+     * Pure virtual function. Called when green light of greenRoad would end
+     */
+    virtual uint32_t extendGreen(const std::vector<uint32_t>& queueLengths,
+        const uint32_t greenRoad, const uint32_t greenTicks) const = 0;
+
+protected:
+    SignalController() = default;
+};
+
+/*!
+ * \brief The FixedTimeSignalController class
+ *
+ * Gives green light to incoming roads in round-robin order for default duration,
+ * regardless of queues. Default controller of junctions
+ */
+class FixedTimeSignalController : public SignalController
+{
+public:
+    FixedTimeSignalController();
+    ~FixedTimeSignalController();
+
+    SignalPhase selectPhase(const std::vector<uint32_t>& queueLengths,
+        const uint32_t lastGreenRoad, const uint32_t defaultGreenTicks) const override;
+    uint32_t extendGreen(const std::vector<uint32_t>& queueLengths, const uint32_t greenRoad,
+        const uint32_t greenTicks) const override;
+};
+
+/*!
+ * \brief The MaxPressureSignalController class
+ *
+ * Gives green light for default duration to road with highest pressure. Every incoming
+ * road of junction leads to all its outgoing roads, so downstream queues are the same for
+ * each phase and pressure of road is its queue length. Ties are broken in round-robin
+ * order starting after last green road
+ */
+class MaxPressureSignalController : public SignalController
+{
+public:
+    MaxPressureSignalController();
+    ~MaxPressureSignalController();
+
+    SignalPhase selectPhase(const std::vector<uint32_t>& queueLengths,
+        const uint32_t lastGreenRoad, const uint32_t defaultGreenTicks) const override;
+    uint32_t extendGreen(const std::vector<uint32_t>& queueLengths, const uint32_t greenRoad,
+        const uint32_t greenTicks) const override;
+};
+
+/*!
+ * \brief The ActuatedSignalController class
+ *
+ * Gives green light in round-robin order skipping roads without vehicles. Green light
+ * lasts at least minGreenTicks and is extended by extensionTicks while there are
+ * vehicles on green road, up to maxGreenTicks
+ */
+class ActuatedSignalController : public SignalController
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param uint32_t minGreenTicks
+     * \param uint32_t maxGreenTicks
+     * \param uint32_t extensionTicks
+     */
+    ActuatedSignalController(const uint32_t minGreenTicks, const uint32_t maxGreenTicks,
+        const uint32_t extensionTicks);
+    ~ActuatedSignalController();
+
+    SignalPhase selectPhase(const std::vector<uint32_t>& queueLengths,
+        const uint32_t lastGreenRoad, const uint32_t defaultGreenTicks) const override;
+    uint32_t extendGreen(const std::vector<uint32_t>& queueLengths, const uint32_t greenRoad,
+        const uint32_t greenTicks) const override;
+
+private:
+    const uint32_t minGreenTicks_;
+    const uint32_t maxGreenTicks_;
+    const uint32_t extensionTicks_;
+};
+
+/* shared by all junctions that were not given other controller */
+inline const auto FIXEDTIMESIGNALCONTROLLER =
+    std::shared_ptr<const SignalController>{std::make_shared<FixedTimeSignalController>()};
+
+} // trafficsimulation::model
+
+#endif // SIGNALCONTROLLER_HPP
@@ -1,17 +1,28 @@
 #ifndef SIMULATION_HPP
 #define SIMULATION_HPP
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
-#include <QObject>
-#include <QTimer>
+#include "../common/Frame.hpp"
+#include "../common/RandomGenerator.hpp"
+#include "../common/TripleBuffer.hpp"
+#include "Demand.hpp"
+#include "DriverDistribution.hpp"
+#include "TimerWheel.hpp"
 
-namespace trafficsimulation::common{ class Point; }
+class QTimer;
 
 namespace trafficsimulation::interface
 {
+class DensityPainter;
 class LinePainter;
 class PointPainter;
 }
@@ -19,31 +30,80 @@ class PointPainter;
 namespace trafficsimulation::model
 {
 
+constexpr auto DEFAULTPEDESTRIANMAXSPEED = Range<uint32_t>{40, 120};
+
+struct Checkpoint;
 class Driver;
 class Junction;
+struct Network;
 class Path;
+struct PathState;
 class Pedestrian;
 class Road;
 enum class RoadCondition;
+struct RoadStatistics;
+struct Route;
+class SignalController;
+class TrajectoryRecorder;
 class Vehicle;
 
+/*!
+ * \brief The PaintedObject struct
+ *
+ * Painter of driver or pedestrian and positions of its object in two latest frames taken
+ * by view, HIDDENPOINT if object is missing in frame. Tick is tick of latest frame that
+ * had object or tick at which painter was added, painter is released when frame made
+ * after that tick misses object
+ */
+struct PaintedObject
+{
+    interface::PointPainter* painter;
+    uint64_t tick;
+    common::Point previousPoint;
+    common::Point point;
+};
+
 /*!
  * \brief The Simulation class
  *
  * Main class of model classes, add objects to simulation, sets their painters and
- * takts simulation.
+ * takts simulation. Started simulation is stepped by engine thread that publishes frame
+ * of each tick through triple buffer, painters of drivers and pedestrians are moved to
+ * the latest frame by simulationRefreshTimer_ on thread of view, so neither of them
+ * waits for the other one. simulationRefreshTimer_ is created by first start(), simulation
+ * that is only run() creates no Qt objects and can be used from any thread.
  */
-class Simulation : public QObject
+class Simulation
 {
-    Q_OBJECT
-
 public:
     /*!
      * \brief Simulation
      *
-     * Initializes Timer that will run simulation
+     * Seed is taken from current time
      */
     Simulation();
+    /*!
+     * \brief Simulation
+     * \param uint64_t seed
+     *
+     * Simulations with the same seed, objects added in the same order and the same number
+     * of ticks are identical
+     */
+    explicit Simulation(const uint64_t seed);
+    /*!
+     * \brief Simulation
+     * \param uint64_t seed
+     * \param Network network
+     *
+     * Creates junctions and paths of network without painters and uses its fastest
+     * routes instead of calculating them again
+     */
+    Simulation(const uint64_t seed, const Network& network);
+    /*!
+     * \brief Destructor
+     *
+     * Stops engine thread if simulation is running
+     */
     ~Simulation();
 
     /*!
@@ -57,28 +117,126 @@ public:
     void setBasePrinters(interface::PointPainter* const junctionPainter,
         interface::LinePainter* const roadPainter,
         interface::LinePainter* const pavementPainter);
+    /*!
+     * \brief setDensityPainter
+     * \param interface::DensityPainter* densityPainter
+     *
+     * Sets painter of loads of roads, loads are added to frames only if it is set.
+     * Has to be called before simulation is started
+     */
+    void setDensityPainter(interface::DensityPainter* const densityPainter);
     /*!
      * \brief start
      * \param uint32_t timeout
      * \return if there was error starting simulation returns error message
      *
-     * Starts simulationRefreshTimer_ with given timeout value
+     * Starts engine thread that makes one tick every timeout milliseconds and
+     * simulationRefreshTimer_ that paints frames every REFRESHINTERVAL milliseconds,
+     * or every timeout milliseconds if it is shorter. Timer is created on first start,
+     * so it has to be called from thread of view
      */
     std::optional<std::string> start(uint32_t timeout);
     /*!
      * \brief stop
      *
-     * Stops simulationRefreshTimer_
+     * Stops engine thread after tick it is making and paints its last frame
      */
     void stop();
     /*!
      * \brief isRunning
-     * \return true if simulationRefreshTimer_ is running
+     * \return true if engine thread is running
      */
     bool isRunning();
+    /*!
+     * \brief run
+     * \param uint64_t ticks
+     * \return if simulation could not be run returns error message
+     *
+     * Runs given number of ticks at once without timer, used to run simulation
+     * without view
+     */
+    std::optional<std::string> run(const uint64_t ticks);
+    /*!
+     * \brief startRecording
+     * \param std::string filePath
+     * \return if recording could not be started returns error message
+     *
+     * Writes layout of simulation to filePath, then frame of each tick is appended
+     * until stopRecording() is called
+     */
+    std::optional<std::string> startRecording(const std::string& filePath);
+    /*!
+     * \brief stopRecording
+     *
+     * Closes trajectory file, does nothing if simulation is not recorded
+     */
+    void stopRecording();
+    bool isRecording() const;
+    uint64_t getSeed() const;
+    /*!
+     * \brief setDestination
+     * \param uint32_t destinationId
+     *
+     * Sets destination of all drivers and pedestrians. If simulation is running it is set
+     * by engine thread before its next tick
+     */
+    void setDestination(const uint32_t destinationId);
+    /*!
+     * \brief setVisibleArea
+     * \param common::Point topLeft
+     * \param common::Point bottomRight
+     *
+     * Sets part of scene shown by view, can be called while simulation is running by one
+     * thread at a time. Engine applies both corners together at start of tick. Drivers and
+     * pedestrians on paths outside of it do not calculate their positions and are in frames
+     * at common::HIDDENPOINT. Whole scene is visible by default and while simulation is
+     * recorded
+     */
+    void setVisibleArea(const common::Point topLeft, const common::Point bottomRight);
+    /*!
+     * \brief setDriverDistribution
+     * \param DriverDistribution driverDistribution
+     *
+     * Sets ranges of parameters of drivers added with random parameters
+     */
+    void setDriverDistribution(const DriverDistribution& driverDistribution);
+    /*!
+     * \brief setSignalController
+     * \param std::shared_ptr<const SignalController> signalController
+     *
+     * Sets strategy that controls lights of all junctions, including ones added later
+     */
+    void setSignalController(const std::shared_ptr<const SignalController> signalController);
+    /*!
+     * \brief setDemand
+     * \param Demand demand
+     * \return if flow of demand uses unknown junction returns error message
+     *
+     * Each tick spawns agents of every flow at its origin junction according to current
+     * rate of flow. Drivers wait at origin until there is free space on first road of
+     * their route. Agents are removed from simulation when they reach destination
+     */
+    std::optional<std::string> setDemand(const Demand& demand);
+    /*!
+     * \brief coordinateCorridor
+     * \param std::vector<uint32_t> junctionIds - ids of junctions in order of driving
+     * \return if junctions are not connected by roads in given order returns error message
+     *
+     * Creates green wave along corridor. All junctions after the first one get the same
+     * cycle, the shortest one that is not shorter than cycle of any of them. Green light
+     * of each corridor road starts when vehicles that got green light at previous
+     * junction reach its end driving at speed limit, so platoons do not stop on corridor.
+     * Offsets hold for fixed time lights
+     */
+    std::optional<std::string> coordinateCorridor(const std::vector<uint32_t>& junctionIds);
 
     const std::vector<std::shared_ptr<Junction>>& getJunctions() const;
-    const std::vector<std::shared_ptr<Driver>>& getDrivers() const;
+    /*!
+     * \brief getDrivers
+     * \return drivers that are updated followed by drivers that sleep in queues before
+     * red lights
+     */
+    std::vector<std::shared_ptr<Driver>> getDrivers() const;
     const std::vector<std::shared_ptr<Pedestrian>>& getPedestrians() const;
     /*!
      * \brief getConnectedJunctionsByRoad
@@ -92,6 +250,47 @@ public:
      * junctions that are connected with it by Pavement
      */
     std::map<uint32_t, std::vector<uint32_t>> getConnectedJunctionsByPavement() const;
+    /*!
+     * \brief getRoadStatistics
+     * \return map where key is id of road and value is its statistics
+     */
+    std::map<uint32_t, RoadStatistics> getRoadStatistics() const;
+    /*!
+     * \brief createNetwork
+     * \param Network& network
+     * \return if network is not complete returns error message
+     *
+     * Calculates fastest routes and describes junctions, paths and routes of simulation
+     * in network, so other simulations can be created from it
+     */
+    std::optional<std::string> createNetwork(Network& network);
+    /*!
+     * \brief captureLayout
+     * \return positions of junctions and lines of roads and pavements
+     */
+    common::Layout captureLayout() const;
+    /*!
+     * \brief captureFrame
+     * \return positions of drivers and pedestrians in current tick
+     */
+    common::Frame captureFrame() const;
+    /*!
+     * \brief createCheckpoint
+     * \return full state of simulation - layout, lights, drivers, pedestrians, vehicle
+     * chains on roads and demand
+     */
+    Checkpoint createCheckpoint() const;
+    /*!
+     * \brief restoreCheckpoint
+     * \param Checkpoint checkpoint
+     * \return if checkpoint does not match simulation returns error message
+     *
+     * Restores state of lights, drivers, pedestrians and demand. Simulation has to be created
+     * with seed of checkpoint and junctions, paths, drivers and pedestrians described by
+     * checkpoint have to be already added in the same order. Painters of objects follow
+     * ids restored from checkpoint
+     */
+    std::optional<std::string> restoreCheckpoint(const Checkpoint& checkpoint);
 
     /*!
      * \brief addJunction
@@ -108,15 +307,16 @@ public:
      * \param uint32_t length
      * \param RoadCondition roadCondition
      * \param uint32_t speedLimit
+     * \param uint32_t laneCount
      * \param interface::LinePainter* painter
      *
-     * Creates new Road from startJunction to endJunction, sets its painter and adds
-     * it to the simulation
+     * Creates new Road with laneCount lanes from startJunction to endJunction, sets its
+     * painter and adds it to the simulation
      */
     void addRoad(const std::shared_ptr<Junction> startJunction,
         const std::shared_ptr<Junction> endJunction, const uint32_t length,
         const RoadCondition roadCondition, const uint32_t speedLimit,
-        interface::LinePainter* const painter);
+        const uint32_t laneCount, interface::LinePainter* const painter);
     /*!
      * \brief addPavement
      * \param std::shared_ptr<Junction> startJunction
@@ -206,19 +406,149 @@ public:
      */
     void addPedestrian(const uint32_t maxSpeed, interface::PointPainter* const painter);
 
+    /*!
+     * \brief addDrivers
+     * \param uint32_t count
+     * \param DriverDistribution distribution
+     *
+     * Creates count drivers with random parameters from distribution and adds them to
+     * the simulation at once, without painters. Storage is reserved up front and
+     * vehicles are queued on spawnRoad_ in order of creation in one pass.
+     * Result is the same as calling addDriver count times with the same distribution
+     */
+    void addDrivers(const uint32_t count, const DriverDistribution& distribution);
+    /*!
+     * \brief addPedestrians
+     * \param uint32_t count
+     * \param Range<uint32_t> maxSpeed
+     *
+     * Creates count pedestrians with random maxSpeed from given range and adds them to
+     * the simulation at once, without painters.
+     * Pedestrians start on spawnPavement_
+     */
+    void addPedestrians(const uint32_t count, const Range<uint32_t> maxSpeed);
+
 private:
+    /*!
+     * \brief runEngine
+     * \param uint32_t timeout
+     *
+     * Body of engine thread. Until stop() is called makes tick every timeout milliseconds
+     * and publishes its frame to frames_
+     */
+    void runEngine(const uint32_t timeout);
+    /*!
+     * \brief paintFrame
+     *
+     * Called by simulationRefreshTimer_. Moves painters of drivers and pedestrians between
+     * their positions in two latest published frames by part of tick that passed since
+     * the latest one was taken, so engine can tick slower than view is refreshed.
+     * Painters of objects missing in frame are hidden. If simulation is not running
+     * painters are moved to the latest frame. Passes loads of roads of new frame to
+     * densityPainter_
+     */
+    void paintFrame();
+    /*!
+     * \brief updateVisiblePaths
+     *
+     * Called at start of each tick. If visible area changed since previous tick sets
+     * visibility of all roads and pavements and updates positions of sleeping drivers
+     */
+    void updateVisiblePaths();
+    /*!
+     * \brief applyDestination
+     * \param uint32_t destinationId
+     *
+     * Sets destination of all drivers and pedestrians
+     */
+    void applyDestination(const uint32_t destinationId);
+    /*!
+     * \brief fillFrame
+     * \param common::Frame& frame
+     *
+     * Writes positions of drivers and pedestrians in current tick to frame, reusing its
+     * storage. If densityPainter_ is set writes also loads of roads
+     */
+    void fillFrame(common::Frame& frame) const;
     /*!
      * \brief updateObjects
      *
-     * Called by simulationRefreshTimer_. Calls update() of objects that are part of
-     * simulation
+     * Called by engine thread or run(). Calls update() of objects that are part of
+     * simulation. Junctions are updated only in ticks in which their lights change.
+     * Drivers that wait before red light are moved to sleepingDrivers_ and are not
+     * updated until light of their road turns green or their queue changes
      */
     void updateObjects();
+    /*!
+     * \brief wakeDrivers
+     * \param bool lightsChanged - true if any junction changed its lights in this tick
+     *
+     * Moves drivers of roads that got green light or whose sleeping vehicle got new
+     * vehicle ahead from sleepingDrivers_ back to drivers_, vehicle closest to junction first
+     */
+    void wakeDrivers(const bool lightsChanged);
+    /*!
+     * \brief sleepDriver
+     * \param std::size_t index
+     *
+     * Moves driver from drivers_ to wait list of its road by moving last driver in its place
+     */
+    void sleepDriver(const std::size_t index);
+    /*!
+     * \brief validate
+     * \return if any junction has no road or pavement going out of it returns
+     * error message
+     */
+    std::optional<std::string> validate() const;
+    /*!
+     * \brief validateDemand
+     * \param Demand demand
+     * \return if flow of demand does not connect two different junctions returns error
+     * message
+     */
+    std::optional<std::string> validateDemand(const Demand& demand) const;
+    /*!
+     * \brief findJunction
+     * \param uint32_t junctionId
+     * \return junction of junctionId or nullptr if there is no such junction
+     */
+    std::shared_ptr<Junction> findJunction(const uint32_t junctionId) const;
+    /*!
+     * \brief spawnDemand
+     *
+     * Spawns agents of flows of demand_ at their origin junctions
+     */
+    void spawnDemand();
+    /*!
+     * \brief drawArrivals
+     * \param DemandFlow flow
+     * \return number of agents of flow that arrive in current tick
+     */
+    uint32_t drawArrivals(const DemandFlow& flow);
+    /*!
+     * \brief releaseDriver
+     * \param std::size_t index
+     *
+     * Removes driver that reached destination from drivers_ by moving last driver in its
+     * place. If simulation is the only owner of driver, driver and its vehicle are kept
+     * in free lists and reused by next spawned driver
+     */
+    void releaseDriver(const std::size_t index);
+    /*!
+     * \brief releasePedestrian
+     * \param std::size_t index
+     *
+     * Removes pedestrian that reached destination from pedestrians_ by moving last
+     * pedestrian in its place. If simulation is the only owner of pedestrian, it is kept
+     * in free list and reused by next spawned pedestrian
+     */
+    void releasePedestrian(const std::size_t index);
 
     /*!
      * \brief calculateFastestRoutes
      *
-     * Calculates fastest routes between junctions and sets them in each junction
+     * Calculates fastest routes between junctions if network changed since last
+     * calculation and sets them in each junction
      */
     void calculateFastestRoutes();
 
@@ -261,32 +591,74 @@ private:
      * spawnRoad_, spawnPavement_ start from outside of the view (-50, -50)
      */
     void generateBaseSimulation();
+    /*!
+     * \brief capturePaths
+     * \return states of all roads and pavements sorted by their ids
+     */
+    std::vector<PathState> capturePaths() const;
     /*!
      * \brief generateRandomVehicle
-     * \return
+     * \param DriverDistribution distribution
+     * \return vehicle with parameters from distribution
      *
-     * Generates new Vehicle with values:
+     * Generates new Vehicle with parameters from distribution, by default
+     * (DEFAULTDRIVERDISTRIBUTION):
      *  - maxAcceleration between (5 - 8)
-     *  - maxDeceleration between (14 - 24)
+     *  - maxDeceleration between (10 - 24)
      */
-    std::unique_ptr<Vehicle> generateRandomVehicle() const;
+    std::unique_ptr<Vehicle> generateRandomVehicle(const DriverDistribution& distribution);
     /*!
      * \brief generateRandomDriver
-     * \return
+     * \param std::shared_ptr<Road> road
+     * \param std::unique_ptr<Vehicle> vehicle
+     * \param DriverDistribution distribution
+     * \return driver driving vehicle with parameters from distribution
      *
-     * Generates random vehicle with:
+     * Generates random driver starting on road with parameters from distribution, by default
+     * (DEFAULTDRIVERDISTRIBUTION):
      *  - accelerationRate between (0.2 - 1)
      *  - minDistanceToVehicleAhead between (1000 - 9000)
      *  - maxSpeedOverLimit between (0 - 300)
      *  - roadConditionSpeedModifier between (0 - 0.15)
      */
-    std::shared_ptr<Driver> generateRandomDriver(std::unique_ptr<Vehicle> vehicle) const;
+    std::shared_ptr<Driver> generateRandomDriver(const std::shared_ptr<Road> road,
+        std::unique_ptr<Vehicle> vehicle, const DriverDistribution& distribution);
+    /*!
+     * \brief createVehicle
+     * \param uint32_t maxAcceleration
+     * \param uint32_t maxDeceleration
+     * \return vehicle taken from freeVehicles_ or newly allocated one
+     */
+    std::unique_ptr<Vehicle> createVehicle(const uint32_t maxAcceleration,
+        const uint32_t maxDeceleration);
+    /*!
+     * \brief createDriver
+     * \param std::shared_ptr<Road> road
+     * \param std::unique_ptr<Vehicle> vehicle
+     * \param float accelerationRate
+     * \param uint32_t minDistanceToVehicleAhead
+     * \param uint32_t maxSpeedOverLimit
+     * \param float roadConditionSpeedModifier
+     * \return driver with next free id taken from freeDrivers_ or newly allocated one
+     */
+    std::shared_ptr<Driver> createDriver(const std::shared_ptr<Road> road,
+        std::unique_ptr<Vehicle> vehicle, const float accelerationRate,
+        const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
+        const float roadConditionSpeedModifier);
+    /*!
+     * \brief createPedestrian
+     * \param std::shared_ptr<Path> pavement
+     * \param uint32_t maxSpeed
+     * \return pedestrian with next free id taken from freePedestrians_ or newly allocated one
+     */
+    std::shared_ptr<Pedestrian> createPedestrian(const std::shared_ptr<Path> pavement,
+        const uint32_t maxSpeed);
     /*!
      * \brief addDriver
      * \param std::shared_ptr<Driver> driver
      * \param interface::PointPainter* painter
      *
-     * Sets drivers painter and adds driver to drivers_
+     * Adds painter to driverPainters_ under id of driver and driver to drivers_
      */
     void addDriver(std::shared_ptr<Driver> driver, interface::PointPainter* const painter);
     /*!
@@ -294,20 +666,61 @@ private:
      * \param std::shared_ptr<Pedestrian> pedestrian
      * \param interface::PointPainter* painter
      *
-     * Sets pedestrians painter and adds pedestrian to pedestrians_
+     * Adds painter to pedestrianPainters_ under id of pedestrian and pedestrian to
+     * pedestrians_
      */
     void addPedestrian(std::shared_ptr<Pedestrian> pedestrian,
         interface::PointPainter* const painter);
 
+    const uint64_t seed_;
     uint32_t junctionId_;
     uint32_t pathId_;
+    uint32_t movingObjectId_;
+    common::RandomGenerator random_;
+    DriverDistribution driverDistribution_;
     std::vector<std::shared_ptr<Junction>> junctions_;
     std::vector<std::shared_ptr<Driver>> drivers_;
     std::vector<std::shared_ptr<Pedestrian>> pedestrians_;
+    /* wait lists of roads ending at junctions, drivers are stored in order they fell asleep */
+    std::map<uint32_t /* roadId */, std::vector<std::shared_ptr<Driver>>> sleepingDrivers_;
+    std::vector<std::shared_ptr<Driver>> freeDrivers_;
+    std::vector<std::shared_ptr<Pedestrian>> freePedestrians_;
+    std::vector<std::unique_ptr<Vehicle>> freeVehicles_;
     std::map<uint32_t, std::vector<std::shared_ptr<Road>>> roadConnections_;
     std::map<uint32_t, std::vector<std::shared_ptr<Path>>> pavementConnections_;
     std::shared_ptr<Road> spawnRoad_;
     std::shared_ptr<Path> spawnPavement_;
+    std::map<uint32_t /* junctionId */, std::shared_ptr<const std::map<uint32_t, Route>>> fastestRoutes_;
+    std::shared_ptr<const SignalController> signalController_;
+    Demand demand_;
+    std::vector<uint32_t> waitingDrivers_;
+
+    uint64_t tick_;
+    /* timers of light changes of junctions, timer id is index of junction in junctions_ */
+    TimerWheel lightTimers_;
+    std::unique_ptr<TrajectoryRecorder> recorder_;
+
+    /* painters are moved by paintFrame() between two latest positions of object of their id */
+    std::unordered_map<uint32_t /* objectId */, PaintedObject> driverPainters_;
+    std::unordered_map<uint32_t /* objectId */, PaintedObject> pedestrianPainters_;
+    interface::DensityPainter* densityPainter_;
+    common::TripleBuffer<common::Frame> frames_;
+    /* latest frame taken by paintFrame() */
+    common::Frame currentFrame_;
+    std::chrono::steady_clock::time_point currentFrameTime_;
+    std::chrono::milliseconds tickInterval_;
+    std::atomic<bool> engineRunning_;
+    /* destination set while simulation is running, NO_DESTINATION if there is none */
+    std::atomic<uint32_t> pendingDestinationId_;
+    /* corners of visible area packed by view thread, visibility of paths matches applied corners.
+     * Version is odd while view thread writes corners, engine reads them again until version
+     * is even and did not change */
+    std::atomic<uint32_t> visibleAreaVersion_;
+    std::atomic<uint64_t> visibleTopLeft_;
+    std::atomic<uint64_t> visibleBottomRight_;
+    uint64_t appliedTopLeft_;
+    uint64_t appliedBottomRight_;
+    std::thread engine_;
 
     std::unique_ptr<QTimer> simulationRefreshTimer_;
     bool basePrintersSet_;
@@ -0,0 +1,74 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace trafficsimulation::model
+{
+
+/*!
+ * \brief The TimerWheel class
+ *
+ * Hierarchical timer wheel of ticks. Each level has WHEELSLOTS slots, slot of level k
+ * holds timers that expire in one of WHEELSLOTS^k consecutive ticks. Timers of higher
+ * levels are moved to lower ones when they get close, so scheduling is O(1) and each
+ * tick costs only as much as timers that expire in it.
+ */
+class TimerWheel
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param uint64_t tick - first tick that will be processed by advance()
+     */
+    explicit TimerWheel(const uint64_t tick);
+    ~TimerWheel();
+
+    /*!
+     * \brief schedule
+     * \param uint64_t tick - tick in which timer expires, if it already passed timer
+     * expires in next processed tick
+     * \param uint32_t timerId
+     */
+    void schedule(const uint64_t tick, const uint32_t timerId);
+    /*!
+     * \brief advance
+     * \return ids of timers that expire in current tick, in order they were scheduled
+     *
+     * Processes current tick and moves to next one
+     */
+    std::vector<uint32_t> advance();
+    /*!
+     * \brief getTick
+     * \return tick that will be processed by next advance()
+     */
+    uint64_t getTick() const;
+
+private:
+    static constexpr auto WHEELLEVELS = std::size_t{4};
+    static constexpr auto SLOTBITS = uint32_t{6};
+    static constexpr auto WHEELSLOTS = std::size_t{1} << SLOTBITS;
+
+    struct Timer
+    {
+        uint64_t tick;
+        uint32_t timerId;
+    };
+
+    /*!
+     * \brief cascade
+     * \param std::size_t level
+     *
+     * Moves timers from slot of level that matches current tick to lower levels
+     */
+    void cascade(const std::size_t level);
+
+    uint64_t tick_;
+    std::array<std::array<std::vector<Timer>, WHEELSLOTS>, WHEELLEVELS> slots_;
+};
+
+} // trafficsimulation::model
+
+#endif // TIMERWHEEL_HPP
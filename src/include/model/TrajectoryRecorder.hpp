@@ -0,0 +1,73 @@
+#ifndef TRAJECTORYRECORDER_HPP
+#define TRAJECTORYRECORDER_HPP
+
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../common/Frame.hpp"
+
+namespace trafficsimulation::model
+{
+
+constexpr auto TRAJECTORYFILEMAGIC = uint32_t{0x52545354}; /* "TSTR" */
+constexpr auto TRAJECTORYFILEVERSION = uint32_t{3};
+
+/*!
+ * \brief The TrajectoryRecorder class
+ *
+ * Writes layout of simulation and frame of each tick to binary trajectory file.
+ * File layout:
+ *  - magic, version, Layout
+ *  - tick, positions and ids of drivers, positions and ids of pedestrians for each recorded
+ *    tick
+ *  - index: offsets of all frames, highest number of drivers and pedestrians in a frame,
+ *    offset of index, magic
+ * Index lets TrajectoryReplay jump to any frame without reading previous ones
+ */
+class TrajectoryRecorder
+{
+public:
+    TrajectoryRecorder();
+    /*!
+     * \brief Destructor
+     *
+     * Closes file if it is still open
+     */
+    ~TrajectoryRecorder();
+
+    /*!
+     * \brief open
+     * \param std::string filePath
+     * \param common::Layout layout
+     * \return if file could not be opened returns error message
+     *
+     * Creates trajectory file and writes its header
+     */
+    std::optional<std::string> open(const std::string& filePath, const common::Layout& layout);
+    /*!
+     * \brief record
+     * \param common::Frame frame
+     *
+     * Appends frame with ids of its objects to file and remembers its offset
+     */
+    void record(const common::Frame& frame);
+    /*!
+     * \brief close
+     *
+     * Writes index of frames and closes file
+     */
+    void close();
+    bool isOpen() const;
+
+private:
+    std::ofstream file_;
+    std::vector<uint64_t> frameOffsets_;
+    uint32_t maxDriverCount_;
+    uint32_t maxPedestrianCount_;
+};
+
+} // trafficsimulation::model
+
+#endif // TRAJECTORYRECORDER_HPP
@@ -0,0 +1,170 @@
+#ifndef TRAJECTORYREPLAY_HPP
+#define TRAJECTORYREPLAY_HPP
+
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QObject>
+#include <QTimer>
+
+#include "../common/Frame.hpp"
+
+namespace trafficsimulation::interface{ class PointPainter; }
+
+namespace trafficsimulation::model
+{
+
+/*!
+ * \brief The TrajectoryReplay class
+ *
+ * Plays back trajectory file written by TrajectoryRecorder through point painters.
+ * Does not run any model logic - positions are read from file. Offsets of frames are
+ * kept in index, so seeking to any frame takes constant time.
+ */
+class TrajectoryReplay : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief TrajectoryReplay
+     *
+     * Initializes Timer that will play replay
+     */
+    TrajectoryReplay();
+    ~TrajectoryReplay();
+
+    /*!
+     * \brief load
+     * \param std::string filePath
+     * \return if file could not be loaded returns error message
+     *
+     * Opens trajectory file, reads its layout and index of frames. If file has no index
+     * (recording was interrupted) index is rebuilt by scanning all frames
+     */
+    std::optional<std::string> load(const std::string& filePath);
+
+    const common::Layout& getLayout() const;
+    uint64_t getFrameCount() const;
+    uint64_t getCurrentFrame() const;
+    /*!
+     * \brief getMaxDriverCount
+     * \return highest number of drivers in any frame of replay
+     */
+    uint32_t getMaxDriverCount() const;
+    /*!
+     * \brief getMaxPedestrianCount
+     * \return highest number of pedestrians in any frame of replay
+     */
+    uint32_t getMaxPedestrianCount() const;
+    /*!
+     * \brief readFrame
+     * \param uint64_t frame
+     * \return frame read from file, it is not painted and does not move playhead. Nothing
+     * if frame is not in replay or is corrupted
+     */
+    std::optional<common::Frame> readFrame(const uint64_t frame);
+
+    /*!
+     * \brief setPainters
+     * \param std::vector<interface::PointPainter*> driverPainters
+     * \param std::vector<interface::PointPainter*> pedestrianPainters
+     *
+     * Sets painters used to show drivers and pedestrians. Object takes free painter when it
+     * appears in painted frame and keeps it while it stays in painted frames
+     */
+    void setPainters(const std::vector<interface::PointPainter*> driverPainters,
+        const std::vector<interface::PointPainter*> pedestrianPainters);
+
+    /*!
+     * \brief play
+     * \param uint32_t timeout
+     *
+     * Starts replayTimer_ with given timeout value
+     */
+    void play(const uint32_t timeout);
+    /*!
+     * \brief pause
+     *
+     * Stops replayTimer_, current frame stays painted
+     */
+    void pause();
+    bool isPlaying() const;
+    /*!
+     * \brief seek
+     * \param uint64_t frame
+     *
+     * Jumps to given frame and paints it
+     */
+    void seek(const uint64_t frame);
+    /*!
+     * \brief setSpeed
+     * \param float speed
+     *
+     * Sets how many frames are advanced on each timeout of replayTimer_,
+     * can be fraction to play slower than recorded
+     */
+    void setSpeed(const float speed);
+
+signals:
+    /*!
+     * \brief frameChanged
+     * \param quint64 frame
+     *
+     * Emitted when new frame was painted
+     */
+    void frameChanged(quint64 frame);
+
+private:
+    /*!
+     * \brief advance
+     *
+     * Called by replayTimer_. Moves playhead_ by speed_ and paints frame under it,
+     * pauses at the end of replay
+     */
+    void advance();
+    /*!
+     * \brief readIndex
+     * \return true if file contains valid index of frames, offsets of frames have to be
+     * increasing and lie between layout and index
+     */
+    bool readIndex();
+    /*!
+     * \brief rebuildIndex
+     *
+     * Scans all frames starting from firstFrameOffset_ and stores their offsets
+     */
+    void rebuildIndex();
+    /*!
+     * \brief paintFrame
+     * \param common::Frame frame
+     *
+     * Sets positions of frame in painters of objects by their ids, painters of objects
+     * missing in frame are moved outside view and freed
+     */
+    void paintFrame(const common::Frame& frame);
+
+    std::ifstream file_;
+    common::Layout layout_;
+    std::vector<uint64_t> frameOffsets_;
+    uint64_t firstFrameOffset_;
+    uint32_t maxDriverCount_;
+    uint32_t maxPedestrianCount_;
+
+    std::unordered_map<uint32_t /* objectId */, interface::PointPainter*> driverPainters_;
+    std::unordered_map<uint32_t /* objectId */, interface::PointPainter*> pedestrianPainters_;
+    std::vector<interface::PointPainter*> freeDriverPainters_;
+    std::vector<interface::PointPainter*> freePedestrianPainters_;
+
+    double playhead_;
+    float speed_;
+    std::unique_ptr<QTimer> replayTimer_;
+};
+
+} // trafficsimulation::model
+
+#endif // TRAJECTORYREPLAY_HPP
@@ -1,17 +1,20 @@
 #ifndef VEHICLE_HPP
 #define VEHICLE_HPP
 
+#include <cstddef>
 #include <memory>
 
 namespace trafficsimulation::model
 {
 
 class Driver;
+class VehicleQueue;
 
 /*!
  * \brief The Vehicle class
  *
- * Holds pointers to vehicle ahead and behind, is frien of Driver class.
+ * Holds pointers to vehicle ahead and behind in the same lane, is frien of Driver class
+ * and of VehicleQueue class that stores index of vehicle in queue of its lane.
  */
 class Vehicle
 {
@@ -24,18 +27,37 @@ public:
     Vehicle(const uint32_t maxAcceleration, const uint32_t maxDeceleration);
     ~Vehicle();
 
+    /*!
+     * \brief reset
+     * \param uint32_t maxAcceleration
+     * \param uint32_t maxDeceleration
+     *
+     * Sets new parameters and clears state, used when vehicle is recycled
+     */
+    void reset(const uint32_t maxAcceleration, const uint32_t maxDeceleration);
+
+    uint32_t getDistanceTravelled() const;
+    bool isAsleep() const;
+    uint32_t getLane() const;
+    void setLane(const uint32_t lane);
+    Vehicle* getVehicleAhead() const;
+    Vehicle* getVehicleBehind() const;
     void setVehicleAhead(Vehicle* const vehicleAhead);
     void setVehicleBehind(Vehicle* const vehicleBehind);
 
 private:
-    const uint32_t maxAcceleration_; /* 5 - 8 */
-    const uint32_t maxDeceleration_; /* 14 - 24 */
+    uint32_t maxAcceleration_; /* 5 - 8 */
+    uint32_t maxDeceleration_; /* 14 - 24 */
     uint32_t speed_;
     uint32_t distanceTravelled_;
+    bool asleep_;
+    uint32_t lane_;
     Vehicle* vehicleAhead_;
     Vehicle* vehicleBehind_;
+    std::size_t queueIndex_;
 
     friend class Driver;
+    friend class VehicleQueue;
 };
 
 } // trafficsimulation::model
@@ -0,0 +1,131 @@
+#ifndef VEHICLEQUEUE_HPP
+#define VEHICLEQUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace trafficsimulation::model
+{
+
+class Vehicle;
+
+/*!
+ * \brief The VehicleQueue class
+ *
+ * Ring buffer of vehicles of one lane ordered from first to last one. Each vehicle stores
+ * its index in buffer, so it is found in O(1). Vehicles enter at the end and leave from
+ * the front in O(1), vehicle that leaves from the middle leaves a hole that is filled by
+ * next vehicle inserted in its place or removed when holes outnumber vehicles, so erase
+ * is O(1) amortized. Place of vehicle that changes lane is found in O(log n). Capacity
+ * grows in powers of two and is never released, so buffers of busy roads stop allocating.
+ */
+class VehicleQueue
+{
+public:
+    VehicleQueue();
+    ~VehicleQueue();
+
+    bool isEmpty() const;
+    /*!
+     * \brief getSize
+     * \return number of vehicles in queue
+     */
+    std::size_t getSize() const;
+    Vehicle* getFirst() const;
+    Vehicle* getLast() const;
+    /*!
+     * \brief findPlace
+     * \param uint32_t distanceTravelled
+     * \return first vehicle that travelled less than distanceTravelled, nullptr if there
+     * is no such vehicle
+     */
+    Vehicle* findPlace(const uint32_t distanceTravelled) const;
+
+    /*!
+     * \brief reserve
+     * \param std::size_t count
+     *
+     * Grows buffer once, so count vehicles can be pushed back without reallocation
+     */
+    void reserve(const std::size_t count);
+    void pushBack(Vehicle* const vehicle);
+    void popFront();
+    /*!
+     * \brief insert
+     * \param Vehicle* vehicleBehind - vehicle of queue, nullptr to insert at the end
+     * \param Vehicle* vehicle
+     *
+     * Inserts vehicle right ahead of vehicleBehind. If there is hole ahead of vehicleBehind
+     * vehicle takes it, otherwise vehicles from vehicleBehind to next hole are moved one
+     * place back
+     */
+    void insert(Vehicle* const vehicleBehind, Vehicle* const vehicle);
+    /*!
+     * \brief erase
+     * \param Vehicle* vehicle
+     * \return false if vehicle is not in queue
+     *
+     * Checks first vehicle before its stored index, because vehicles usually leave from front
+     */
+    bool erase(Vehicle* const vehicle);
+    void clear();
+
+private:
+    /*!
+     * \brief getIndex
+     * \param std::size_t position
+     * \return index in vehicles_ of place at position, counted from first vehicle
+     */
+    std::size_t getIndex(const std::size_t position) const;
+    /*!
+     * \brief getPosition
+     * \param Vehicle* vehicle
+     * \return position of vehicle or size_ if it is not in queue
+     */
+    std::size_t getPosition(const Vehicle* const vehicle) const;
+    /*!
+     * \brief findVehicle
+     * \param std::size_t position
+     * \return position of first vehicle at or behind position, size_ if there is none
+     */
+    std::size_t findVehicle(std::size_t position) const;
+    /*!
+     * \brief setVehicle
+     * \param std::size_t position
+     * \param Vehicle* vehicle
+     *
+     * Puts vehicle at position and stores its index in vehicle
+     */
+    void setVehicle(const std::size_t position, Vehicle* const vehicle);
+    /*!
+     * \brief reserve
+     *
+     * Called when buffer is full, removes holes or doubles capacity if vehicles take at
+     * least half of it
+     */
+    void reserve();
+    /*!
+     * \brief compact
+     *
+     * Moves vehicles forward, so there are no holes between them
+     */
+    void compact();
+    /*!
+     * \brief grow
+     * \param std::size_t capacity - power of two that fits all vehicles
+     *
+     * Changes capacity and moves vehicles without holes to start of vehicles_
+     */
+    void grow(const std::size_t capacity);
+
+    /* places between first and last vehicle, nullptr for holes */
+    std::vector<Vehicle*> vehicles_;
+    std::size_t first_;
+    /* number of places from first to last vehicle, including holes */
+    std::size_t size_;
+    std::size_t vehicleCount_;
+};
+
+} // trafficsimulation::model
+
+#endif // VEHICLEQUEUE_HPP
@@ -0,0 +1,73 @@
+#ifndef DENSITYLAYER_HPP
+#define DENSITYLAYER_HPP
+
+#include <vector>
+
+#include <QGraphicsItem>
+#include <QRectF>
+
+#include "../interface/DensityPainter.hpp"
+#include "../common/Frame.hpp"
+
+namespace trafficsimulation::view
+{
+
+/*!
+ * \brief The DensityLayer class
+ *
+ * Inherits interface::DensityPainter abstract class and QGraphicsItem class.
+ * Shades roads by their load, from green for empty road to red for jammed one. It is
+ * painted only below AGENTSMINSCALE, where agents are not painted, so cost of frame does
+ * not grow with number of agents when view is zoomed out.
+ */
+class DensityLayer : public interface::DensityPainter, public QGraphicsItem
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param QRectF sceneRect - area of roads
+     */
+    explicit DensityLayer(const QRectF sceneRect);
+    ~DensityLayer();
+
+    /*!
+     * \brief setRoadLoads
+     * \param std::vector<common::RoadLoad> roadLoads
+     *
+     * Overrides and implements interface::DensityPainter::setRoadLoads method
+     */
+    void setRoadLoads(const std::vector<common::RoadLoad>& roadLoads) override;
+    /*!
+     * \brief paint
+     *
+     * Overrides and implements interface::DensityPainter::paint method. Schedules repaint
+     * only if layer was painted below AGENTSMINSCALE last time
+     */
+    void paint() override;
+    /*!
+     * \brief setSceneRect
+     * \param QRectF sceneRect - area of roads
+     */
+    void setSceneRect(const QRectF sceneRect);
+
+    /*!
+     * \brief paint
+     * \param QPainter *painter
+     * \param QStyleOptionGraphicsItem *option
+     * \param QWidget *widget
+     *
+     * Implementation of QGraphicsItem::paint method
+     */
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    QRectF boundingRect() const override;
+
+private:
+    QRectF sceneRect_;
+    std::vector<common::RoadLoad> roadLoads_;
+    qreal paintedScale_;
+};
+
+} // trafficsimulation::view
+
+#endif // DENSITYLAYER_HPP
@@ -0,0 +1,111 @@
+#ifndef FRAMEEXPORTER_HPP
+#define FRAMEEXPORTER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <QImage>
+
+namespace trafficsimulation::view
+{
+
+/*!
+ * \brief The ExportFormat enum
+ *
+ * PngSequence - every image is written to its own numbered PNG file in output directory
+ * RawVideo - images are appended to one file as raw 24 bit RGB frames without header,
+ *            it can be encoded by video tools that read rawvideo stream
+ */
+enum class ExportFormat
+{
+    PngSequence,
+    RawVideo
+};
+
+/*!
+ * \brief The FrameExporter class
+ *
+ * Writes images on encoder thread, so caller can render next image while previous one is
+ * compressed and saved. At most EXPORTQUEUESIZE images wait for encoder, write() blocks
+ * when queue is full, so memory used does not grow with length of export.
+ */
+class FrameExporter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param ExportFormat format
+     */
+    explicit FrameExporter(const ExportFormat format);
+    /*!
+     * \brief Destructor
+     *
+     * Closes exporter if it is still open
+     */
+    ~FrameExporter();
+
+    /*!
+     * \brief open
+     * \param std::string outputPath - directory of PngSequence or file of RawVideo
+     * \return if output could not be created returns error message
+     *
+     * Creates output and starts encoder thread
+     */
+    std::optional<std::string> open(const std::string& outputPath);
+    /*!
+     * \brief write
+     * \param QImage image
+     * \return if exporter is not open or previous image could not be written returns error
+     * message, image is not queued then
+     *
+     * Queues image for encoder thread, blocks while queue is full
+     */
+    std::optional<std::string> write(const QImage& image);
+    /*!
+     * \brief close
+     * \return if any image could not be written returns error message
+     *
+     * Waits until all queued images are written and stops encoder thread
+     */
+    std::optional<std::string> close();
+    /*!
+     * \brief getFrameCount
+     * \return number of images written since open()
+     */
+    uint64_t getFrameCount();
+
+private:
+    /*!
+     * \brief runEncoder
+     *
+     * Body of encoder thread, writes queued images until exporter is closed
+     */
+    void runEncoder();
+    /*!
+     * \brief encode
+     * \param QImage image
+     * \param uint64_t frame - number of image in export
+     * \return if image could not be written returns error message
+     */
+    std::optional<std::string> encode(const QImage& image, const uint64_t frame);
+
+    const ExportFormat format_;
+    std::string outputPath_;
+    std::ofstream videoFile_;
+    std::deque<QImage> queue_;
+    uint64_t frameCount_;
+    bool closing_;
+    std::optional<std::string> error_;
+    std::mutex mutex_;
+    std::condition_variable queueChanged_;
+    std::thread encoder_;
+};
+
+} // trafficsimulation::view
+
+#endif // FRAMEEXPORTER_HPP
@@ -0,0 +1,53 @@
+#ifndef FRAMERENDERER_HPP
+#define FRAMERENDERER_HPP
+
+#include <QImage>
+#include <QSize>
+#include <QTransform>
+
+#include "../common/Frame.hpp"
+
+namespace trafficsimulation::view
+{
+
+/*!
+ * \brief The FrameRenderer class
+ *
+ * Draws frames of simulation into images with raster QPainter, so it needs neither
+ * visible window nor QGraphicsScene. Layout is scaled to fit image and drawn only once,
+ * each frame starts from copy of that image and adds drivers and pedestrians to it.
+ */
+class FrameRenderer
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param common::Layout layout - junctions, roads and pavements drawn in every image
+     * \param QSize imageSize
+     */
+    FrameRenderer(const common::Layout& layout, const QSize imageSize);
+    ~FrameRenderer();
+
+    /*!
+     * \brief render
+     * \param common::Frame frame
+     * \return image of layout with drivers and pedestrians of frame
+     */
+    QImage render(const common::Frame& frame) const;
+
+private:
+    /*!
+     * \brief renderLayout
+     * \param common::Layout layout
+     *
+     * Draws pavements, roads and junctions into networkImage_
+     */
+    void renderLayout(const common::Layout& layout);
+
+    QTransform transform_;
+    QImage networkImage_;
+};
+
+} // trafficsimulation::view
+
+#endif // FRAMERENDERER_HPP
@@ -0,0 +1,199 @@
+#ifndef NETWORKLAYER_HPP
+#define NETWORKLAYER_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QGraphicsItem>
+#include <QPixmap>
+#include <QRectF>
+
+#include "../interface/LinePainter.hpp"
+#include "../interface/PointPainter.hpp"
+#include "../common/Point.hpp"
+#include "PathPainters.hpp"
+#include "PointPainters.hpp"
+
+namespace trafficsimulation::view
+{
+
+class NetworkLayer;
+
+/*!
+ * \brief The NetworkPathPainter class
+ *
+ * Inherits interface::LinePainter abstract class.
+ * Passes points of single path to PathPainter that is painted by NetworkLayer, is not
+ * item of scene.
+ */
+class NetworkPathPainter : public interface::LinePainter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param NetworkLayer* layer - layer that paints path
+     * \param std::unique_ptr<PathPainter> pathPainter - painter used to paint path
+     */
+    NetworkPathPainter(NetworkLayer* const layer, std::unique_ptr<PathPainter> pathPainter);
+    ~NetworkPathPainter();
+
+    /*!
+     * \brief setPoints
+     * \param common::Point startPoint
+     * \param common::Point endPoint
+     *
+     * Overrides and implements interface::LinePainter::setPoints method, invalidates
+     * cache of layer
+     */
+    void setPoints(const common::Point startPoint, const common::Point endPoint) override;
+    /*!
+     * \brief paint
+     *
+     * Overrides and implements interface::LinePainter::paint method. Path is in cache of
+     * layer, so nothing is done
+     */
+    void paint() override;
+
+    /*!
+     * \brief getPathPainter
+     * \return painter used to paint path
+     */
+    PathPainter* getPathPainter() const;
+
+private:
+    NetworkLayer* const layer_;
+    const std::unique_ptr<PathPainter> pathPainter_;
+};
+
+/*!
+ * \brief The NetworkJunctionPainter class
+ *
+ * Inherits interface::PointPainter abstract class.
+ * Stores point of single junction that NetworkLayer paints with JunctionPainter, is not
+ * item of scene.
+ */
+class NetworkJunctionPainter : public interface::PointPainter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param NetworkLayer* layer - layer that paints junction
+     */
+    explicit NetworkJunctionPainter(NetworkLayer* const layer);
+    ~NetworkJunctionPainter();
+
+    /*!
+     * \brief setPoint
+     * \param common::Point point
+     *
+     * Overrides and implements interface::PointPainter::setPoint method
+     */
+    void setPoint(const common::Point point) override;
+    /*!
+     * \brief paint
+     *
+     * Overrides and implements interface::PointPainter::paint method. Invalidates cache of
+     * layer only if junction was moved
+     */
+    void paint() override;
+
+    /*!
+     * \brief getJunctionPainter
+     * \return painter used to paint junction
+     */
+    JunctionPainter* getJunctionPainter() const;
+    /*!
+     * \brief getPaintedPoint
+     * \return point of junction at last paint() call, JunctionPainter paints around (0, 0)
+     */
+    common::Point getPaintedPoint() const;
+
+private:
+    NetworkLayer* const layer_;
+    const std::unique_ptr<JunctionPainter> junctionPainter_;
+    common::Point point_;
+    common::Point paintedPoint_;
+};
+
+/*!
+ * \brief The NetworkLayer class
+ *
+ * Inherits QGraphicsItem class.
+ * Paints static part of simulation - roads, pavements and junctions. They are rendered
+ * once into pixmap of device resolution and layer paints only this pixmap. Pixmap covers
+ * only exposed part of network with some margin, so its size does not depend on size of
+ * network. It is rendered again after map is edited, after scale of view changes or when
+ * view is moved outside of it.
+ */
+class NetworkLayer : public QGraphicsItem
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param QRectF sceneRect - area of network
+     */
+    explicit NetworkLayer(const QRectF sceneRect);
+    ~NetworkLayer();
+
+    /*!
+     * \brief addRoad
+     * \return painter of new road, it is owned by layer
+     */
+    interface::LinePainter* addRoad();
+    /*!
+     * \brief addPavement
+     * \return painter of new pavement, it is owned by layer
+     */
+    interface::LinePainter* addPavement();
+    /*!
+     * \brief addJunction
+     * \return painter of new junction, it is owned by layer
+     */
+    interface::PointPainter* addJunction();
+    /*!
+     * \brief invalidate
+     *
+     * Drops cached pixmap and schedules repaint of layer
+     */
+    void invalidate();
+    /*!
+     * \brief setSceneRect
+     * \param QRectF sceneRect - area of network, cache is dropped
+     */
+    void setSceneRect(const QRectF sceneRect);
+
+    /*!
+     * \brief paint
+     * \param QPainter *painter
+     * \param QStyleOptionGraphicsItem *option
+     * \param QWidget *widget
+     *
+     * Implementation of QGraphicsItem::paint method, renders pixmap if it is not valid
+     * for current scale or does not cover exposed rect and paints it
+     */
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    QRectF boundingRect() const override;
+
+private:
+    /*!
+     * \brief renderCache
+     * \param qreal scale - scale of view
+     * \param QRectF exposedRect - part of layer that has to be painted
+     *
+     * Paints all paths and then all junctions into cache_, which covers exposedRect
+     * extended by CACHEMARGIN
+     */
+    void renderCache(const qreal scale, const QRectF exposedRect);
+
+    QRectF sceneRect_;
+    std::vector<std::unique_ptr<NetworkPathPainter>> pathPainters_;
+    std::vector<std::unique_ptr<NetworkJunctionPainter>> junctionPainters_;
+    QPixmap cache_;
+    QRectF cacheRect_;
+    qreal cacheScale_;
+};
+
+} // trafficsimulation::view
+
+#endif // NETWORKLAYER_HPP
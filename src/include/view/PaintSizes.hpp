@@ -0,0 +1,18 @@
+#ifndef PAINTSIZES_HPP
+#define PAINTSIZES_HPP
+
+#include <cstdint>
+
+namespace trafficsimulation::view
+{
+
+/* sizes of painted objects shared by painters of scene and FrameRenderer */
+constexpr auto JUNCTIONDIAMETER = uint32_t{40};
+constexpr auto DRIVERDIAMETER = uint32_t{10};
+constexpr auto PEDESTRIANDIAMETER = uint32_t{7};
+constexpr auto PAVEMENTPENWIDTH = uint32_t{3};
+constexpr auto ROADPENWIDTH = uint32_t{5};
+
+} // trafficsimulation::view
+
+#endif // PAINTSIZES_HPP
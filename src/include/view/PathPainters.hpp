@@ -13,7 +13,8 @@ namespace trafficsimulation::view
  * \brief The PathPainter abstract class
  *
  * Inherits interface::LinePainter abstract class and QGraphicsItem class.
- * Paints line in simulation.
+ * Paints line in simulation. Item bounds only the line, it is repainted by scene only
+ * when its points change or when items over it move.
  */
 class PathPainter : public interface::LinePainter, public QGraphicsItem
 {
@@ -25,20 +26,28 @@ public:
      * \param common::Point startPoint
      * \param common::Point endPoint
      *
-     * Overrides and implements interface::LinePainter::setPoints method
+     * Overrides and implements interface::LinePainter::setPoints method, repaints area
+     * of old and new line
      */
     void setPoints(const common::Point startPoint, const common::Point endPoint) override;
     /*!
      * \brief paint
      *
-     * Overrides and implements interface::LinePainter::paint method
+     * Overrides and implements interface::LinePainter::paint method. Line does not
+     * change between ticks, so nothing is invalidated
      */
     void paint() override;
 
     QRectF boundingRect() const override;
 
 protected:
-    PathPainter();
+    /*!
+     * \brief Constructor
+     * \param uint32_t penWidth - width of painted line
+     */
+    explicit PathPainter(const uint32_t penWidth);
+
+    const uint32_t penWidth_;
 
     common::Point startPoint_;
     common::Point endPoint_;
@@ -1,8 +1,13 @@
 #ifndef POINTPAINTERS_HPP
 #define POINTPAINTERS_HPP
 
+#include <memory>
+#include <vector>
+
 #include <QColor>
 #include <QGraphicsItem>
+#include <QPointF>
+#include <QRectF>
 
 #include "../interface/PointPainter.hpp"
 #include "../common/Point.hpp"
@@ -10,11 +15,15 @@
 namespace trafficsimulation::view
 {
 
+/* below this scale of view agents are not painted, DensityLayer shades roads instead */
+constexpr auto AGENTSMINSCALE = qreal{0.75};
+
 /*!
  * \brief The PointPainter abstract class
  *
  * Inherits interface::PointPainter abstract class and QGraphicsItem class.
- * Paints single point in simulation.
+ * Paints single point in simulation. Item is placed at the point and bounds only circle
+ * of given diameter, so moving it repaints only area it left and area it entered.
  */
 class PointPainter : public interface::PointPainter, public QGraphicsItem
 {
@@ -32,16 +41,30 @@ public:
     /*!
      * \brief paint
      *
-     * Overrides and implements interface::PointPainter::paint method
+     * Overrides and implements interface::PointPainter::paint method. Moves item to
+     * the point, does nothing if it did not change
      */
     void paint() override;
 
     QRectF boundingRect() const override;
 
 protected:
-    PointPainter();
+    /*!
+     * \brief Constructor
+     * \param uint32_t diameter - diameter of painted circle
+     */
+    explicit PointPainter(const uint32_t diameter);
+
+    /*!
+     * \brief paintCircle
+     * \param QPainter *painter
+     *
+     * Paints circle of diameter_ centered at position of item
+     */
+    void paintCircle(QPainter *painter) const;
 
     common::Point point_;
+    const uint32_t diameter_;
 };
 
 /*!
@@ -119,6 +142,158 @@ private:
     QColor color_;
 };
 
+class AgentLayer;
+
+/*!
+ * \brief The AgentPainter class
+ *
+ * Inherits interface::PointPainter abstract class.
+ * Passes point of single agent to AgentLayer that paints it, is not item of scene.
+ */
+class AgentPainter : public interface::PointPainter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param AgentLayer* layer - layer that paints agent
+     * \param std::size_t agentIndex - index of agent in buffers of layer
+     */
+    AgentPainter(AgentLayer* const layer, const std::size_t agentIndex);
+    ~AgentPainter();
+
+    /*!
+     * \brief setPoint
+     * \param common::Point point
+     *
+     * Overrides and implements interface::PointPainter::setPoint method
+     */
+    void setPoint(const common::Point point) override;
+    /*!
+     * \brief paint
+     *
+     * Overrides and implements interface::PointPainter::paint method. Moves agent in layer
+     */
+    void paint() override;
+    /*!
+     * \brief release
+     *
+     * Overrides interface::PointPainter::release method. Removes agent from layer
+     */
+    void release() override;
+
+private:
+    AgentLayer* const layer_;
+    const std::size_t agentIndex_;
+    common::Point point_;
+};
+
+/*!
+ * \brief The AgentLayer abstract class
+ *
+ * Inherits QGraphicsItem class.
+ * Paints all agents of one kind in single paint call from packed buffers of their
+ * positions and colors, so scene handles one item instead of item per agent. Layer is
+ * repainted at most once per frame, after any of its agents moved. Only agents in exposed
+ * part of view are painted and none of them below AGENTSMINSCALE.
+ */
+class AgentLayer : public QGraphicsItem
+{
+public:
+    virtual ~AgentLayer();
+
+    /*!
+     * \brief addAgent
+     * \return painter of new agent, it is owned by layer. Index and painter of removed agent
+     * are reused before buffers grow
+     */
+    interface::PointPainter* addAgent();
+    /*!
+     * \brief removeAgent
+     * \param std::size_t agentIndex
+     *
+     * Hides agent and frees its index for next added agent
+     */
+    void removeAgent(const std::size_t agentIndex);
+    /*!
+     * \brief moveAgent
+     * \param std::size_t agentIndex
+     * \param common::Point point
+     *
+     * Stores new point of agent and schedules repaint of layer if it changed
+     */
+    void moveAgent(const std::size_t agentIndex, const common::Point point);
+    /*!
+     * \brief setSceneRect
+     * \param QRectF sceneRect - area in which agents move
+     */
+    void setSceneRect(const QRectF sceneRect);
+
+    /*!
+     * \brief paint
+     * \param QPainter *painter
+     * \param QStyleOptionGraphicsItem *option
+     * \param QWidget *widget
+     *
+     * Implementation of QGraphicsItem::paint method, paints circles of all agents
+     */
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    QRectF boundingRect() const override;
+
+protected:
+    /*!
+     * \brief Constructor
+     * \param QRectF sceneRect - area in which agents move
+     * \param uint32_t diameter - diameter of painted circles
+     */
+    AgentLayer(const QRectF sceneRect, const uint32_t diameter);
+
+private:
+    QRectF sceneRect_;
+    const uint32_t diameter_;
+    std::vector<QPointF> positions_;
+    std::vector<QColor> colors_;
+    std::vector<std::unique_ptr<AgentPainter>> painters_;
+    /* indexes of removed agents */
+    std::vector<std::size_t> freeIndexes_;
+    bool repaintScheduled_;
+    qreal paintedScale_;
+};
+
+/*!
+ * \brief The DriverLayer class
+ *
+ * Inherits AgentLayer abstract class.
+ * Paints all Driver objects in simulation.
+ */
+class DriverLayer : public AgentLayer
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param QRectF sceneRect - area in which drivers move
+     */
+    explicit DriverLayer(const QRectF sceneRect);
+    ~DriverLayer();
+};
+
+/*!
+ * \brief The PedestrianLayer class
+ *
+ * Inherits AgentLayer abstract class.
+ * Paints all Pedestrian objects in simulation.
+ */
+class PedestrianLayer : public AgentLayer
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param QRectF sceneRect - area in which pedestrians move
+     */
+    explicit PedestrianLayer(const QRectF sceneRect);
+    ~PedestrianLayer();
+};
+
 } // trafficsimulation::view
 
 #endif // POINTPAINTERS_HPP
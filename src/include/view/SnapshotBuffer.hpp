@@ -0,0 +1,65 @@
+#ifndef SNAPSHOTBUFFER_HPP
+#define SNAPSHOTBUFFER_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QImage>
+#include <QSize>
+
+#include "../interface/SnapshotPainter.hpp"
+#include "FrameRenderer.hpp"
+
+namespace trafficsimulation::view
+{
+
+/*!
+ * \brief The SnapshotBuffer class
+ *
+ * Inherits interface::SnapshotPainter abstract class.
+ * Renders every painted frame with FrameRenderer and keeps images in memory. It uses only
+ * raster QPainter, so it works on machines without display and GPU and each simulation
+ * of EnsembleRunner can paint to its own buffer from its worker thread.
+ */
+class SnapshotBuffer : public interface::SnapshotPainter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param QSize imageSize
+     */
+    explicit SnapshotBuffer(const QSize imageSize);
+    ~SnapshotBuffer();
+
+    /*!
+     * \brief setLayout
+     * \param common::Layout layout
+     *
+     * Overrides and implements interface::SnapshotPainter::setLayout method, creates
+     * renderer of layout and drops images rendered before
+     */
+    void setLayout(const common::Layout& layout) override;
+    /*!
+     * \brief paint
+     * \param common::Frame frame
+     *
+     * Overrides and implements interface::SnapshotPainter::paint method, renders frame
+     * and appends it to snapshots. Frames painted before setLayout() are ignored
+     */
+    void paint(const common::Frame& frame) override;
+
+    /*!
+     * \brief getSnapshots
+     * \return images of painted frames in order of painting
+     */
+    const std::vector<QImage>& getSnapshots() const;
+
+private:
+    const QSize imageSize_;
+    std::unique_ptr<FrameRenderer> renderer_;
+    std::vector<QImage> snapshots_;
+};
+
+} // trafficsimulation::view
+
+#endif // SNAPSHOTBUFFER_HPP
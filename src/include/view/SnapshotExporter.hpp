@@ -0,0 +1,74 @@
+#ifndef SNAPSHOTEXPORTER_HPP
+#define SNAPSHOTEXPORTER_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <QSize>
+
+#include "../interface/SnapshotPainter.hpp"
+#include "FrameExporter.hpp"
+#include "FrameRenderer.hpp"
+
+namespace trafficsimulation::view
+{
+
+/*!
+ * \brief The SnapshotExporter class
+ *
+ * Inherits interface::SnapshotPainter abstract class.
+ * Renders every painted frame with FrameRenderer and writes it with FrameExporter right
+ * away, unlike SnapshotBuffer it keeps no images, so long batch runs do not fill memory.
+ * Each simulation of EnsembleRunner needs its own exporter and output path.
+ */
+class SnapshotExporter : public interface::SnapshotPainter
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param QSize imageSize
+     * \param ExportFormat format
+     * \param std::string outputPath - directory of PngSequence or file of RawVideo
+     */
+    SnapshotExporter(const QSize imageSize, const ExportFormat format,
+        const std::string& outputPath);
+    ~SnapshotExporter();
+
+    /*!
+     * \brief setLayout
+     * \param common::Layout layout
+     *
+     * Overrides and implements interface::SnapshotPainter::setLayout method, creates
+     * renderer of layout and opens output
+     */
+    void setLayout(const common::Layout& layout) override;
+    /*!
+     * \brief paint
+     * \param common::Frame frame
+     *
+     * Overrides and implements interface::SnapshotPainter::paint method, renders frame
+     * and queues it for writing. Frames painted before setLayout() or after error
+     * are ignored
+     */
+    void paint(const common::Frame& frame) override;
+    /*!
+     * \brief close
+     * \return if output could not be opened or any image could not be written returns
+     * error message
+     *
+     * Waits until all painted frames are written
+     */
+    std::optional<std::string> close();
+
+private:
+    const QSize imageSize_;
+    const std::string outputPath_;
+    std::unique_ptr<FrameRenderer> renderer_;
+    FrameExporter exporter_;
+    std::optional<std::string> error_;
+};
+
+} // trafficsimulation::view
+
+#endif // SNAPSHOTEXPORTER_HPP
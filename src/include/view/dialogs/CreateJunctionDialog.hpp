@@ -27,12 +27,15 @@ public:
      * \param uint32_t minValue
      * \param uint32_t maxWidth
      * \param uint32_t maxHeight
+     * \param uint32_t maxValue
      * \param QWidget* parent
      *
-     * Sets minimum and maximum value of SpinBoxes and sets random value from that range.
+     * Sets minimum and maximum value of SpinBoxes and sets random value from range between
+     * minValue and maxWidth or maxHeight. Values up to maxValue can be entered, so junction
+     * can be placed outside of current scene.
      */
     explicit CreateJunctionDialog(const uint32_t minValue, const uint32_t maxWidth,
-        const uint32_t maxHeight, QWidget *parent = nullptr);
+        const uint32_t maxHeight, const uint32_t maxValue, QWidget *parent = nullptr);
     ~CreateJunctionDialog();
 
     common::Point getPoint() const;
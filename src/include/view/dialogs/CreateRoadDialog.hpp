@@ -40,6 +40,7 @@ public:
     uint32_t getLength() const;
     model::RoadCondition getRoadCondition() const;
     uint32_t getSpeedLimit() const;
+    uint32_t getLaneCount() const;
 
     bool bothDirections() const;
     bool createPavement() const;
@@ -0,0 +1,112 @@
+#include "../include/model/Checkpoint.hpp"
+
+#include <fstream>
+
+#include "../include/common/BinaryStream.hpp"
+
+namespace trafficsimulation::model
+{
+
+namespace
+{
+
+void writeFlows(std::ostream& stream, const std::vector<DemandFlow>& flows)
+{
+    common::writeValue(stream, static_cast<uint32_t>(std::size(flows)));
+    for(const auto& flow : flows)
+    {
+        common::writeValue(stream, flow.originId);
+        common::writeValue(stream, flow.destinationId);
+        common::writeVector(stream, flow.rates);
+    }
+}
+
+bool readFlows(std::istream& stream, std::vector<DemandFlow>& flows)
+{
+    auto size = uint32_t{0};
+    if(!common::readValue(stream, size))
+    {
+        return false;
+    }
+    flows.clear();
+    for(auto iterator = uint32_t{0}; iterator < size; ++iterator)
+    {
+        auto flow = DemandFlow{};
+        if(!common::readValue(stream, flow.originId)
+            || !common::readValue(stream, flow.destinationId)
+            || !common::readVector(stream, flow.rates))
+        {
+            return false;
+        }
+        flows.push_back(flow);
+    }
+    return true;
+}
+
+}
+
+std::optional<std::string> writeCheckpoint(const std::string& filePath,
+    const Checkpoint& checkpoint)
+{
+    auto file = std::ofstream{filePath, std::ios::binary | std::ios::trunc};
+    if(!file.is_open())
+    {
+        return "Could not open file " + filePath + " for writing";
+    }
+
+    common::writeValue(file, CHECKPOINTFILEMAGIC);
+    common::writeValue(file, CHECKPOINTFILEVERSION);
+    common::writeValue(file, checkpoint.seed);
+    common::writeValue(file, checkpoint.randomCounter);
+    common::writeValue(file, checkpoint.tick);
+    common::writeVector(file, checkpoint.junctions);
+    common::writeVector(file, checkpoint.paths);
+    common::writeVector(file, checkpoint.drivers);
+    common::writeVector(file, checkpoint.pedestrians);
+    writeFlows(file, checkpoint.demand.driverFlows);
+    writeFlows(file, checkpoint.demand.pedestrianFlows);
+    common::writeValue(file, checkpoint.demand.driverDistribution);
+    common::writeValue(file, checkpoint.demand.pedestrianMaxSpeed);
+    common::writeVector(file, checkpoint.waitingDrivers);
+
+    if(!file.good())
+    {
+        return "Could not write checkpoint to " + filePath;
+    }
+    return {};
+}
+
+std::optional<std::string> readCheckpoint(const std::string& filePath, Checkpoint& checkpoint)
+{
+    auto file = std::ifstream{filePath, std::ios::binary};
+    if(!file.is_open())
+    {
+        return "Could not open file " + filePath;
+    }
+
+    auto magic = uint32_t{0};
+    auto version = uint32_t{0};
+    if(!common::readValue(file, magic) || magic != CHECKPOINTFILEMAGIC
+        || !common::readValue(file, version) || version != CHECKPOINTFILEVERSION)
+    {
+        return "File " + filePath + " is not a simulation checkpoint";
+    }
+    if(!common::readValue(file, checkpoint.seed)
+        || !common::readValue(file, checkpoint.randomCounter)
+        || !common::readValue(file, checkpoint.tick)
+        || !common::readVector(file, checkpoint.junctions)
+        || !common::readVector(file, checkpoint.paths)
+        || !common::readVector(file, checkpoint.drivers)
+        || !common::readVector(file, checkpoint.pedestrians)
+        || !readFlows(file, checkpoint.demand.driverFlows)
+        || !readFlows(file, checkpoint.demand.pedestrianFlows)
+        || !common::readValue(file, checkpoint.demand.driverDistribution)
+        || !common::readValue(file, checkpoint.demand.pedestrianMaxSpeed)
+        || !common::readVector(file, checkpoint.waitingDrivers))
+    {
+        return "Checkpoint " + filePath + " is corrupted";
+    }
+    return {};
+}
+
+} // trafficsimulation::model
@@ -1,9 +1,8 @@
 #include "../include/model/Driver.hpp"
 
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
 
+#include "../include/model/Checkpoint.hpp"
 #include "../include/model/Junction.hpp"
 #include "../include/model/Road.hpp"
 #include "../include/model/Vehicle.hpp"
@@ -12,12 +11,18 @@ namespace trafficsimulation::model
 {
 
 constexpr auto SPEED_TO_DISTANCE_MODIFIER = uint32_t{10};
+/* driver keeps to the right lane if it has this many minDistanceToVehicleAhead_ free */
+constexpr auto FREE_LANE_DISTANCE_MULTIPLIER = uint32_t{4};
 
-Driver::Driver(const std::shared_ptr<Road> road, std::unique_ptr<Vehicle> vehicle,
-    const float accelerationRate, const uint32_t minDistanceToVehicleAhead,
-    const uint32_t maxSpeedOverLimit, const float roadConditionSpeedModifier)
-    : MovingObject{}
+Driver::Driver(const uint32_t driverId, const uint64_t seed, const std::shared_ptr<Road> road,
+    std::unique_ptr<Vehicle> vehicle, const float accelerationRate,
+    const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
+    const float roadConditionSpeedModifier)
+    : MovingObject{driverId, seed}
     , road_{road}
+    , nextRoad_{nullptr}
+    , ticksOnRoad_{0}
+    , asleepSinceTick_{0}
     , vehicle_{std::move(vehicle)}
     , accelerationRate_{accelerationRate}
     , minDistanceToVehicleAhead_{minDistanceToVehicleAhead}
@@ -28,63 +33,287 @@ Driver::Driver(const std::shared_ptr<Road> road, std::unique_ptr<Vehicle> vehicl
 
 Driver::~Driver() = default;
 
+void Driver::respawn(const uint32_t driverId, const std::shared_ptr<Road> road,
+    std::unique_ptr<Vehicle> vehicle, const float accelerationRate,
+    const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
+    const float roadConditionSpeedModifier)
+{
+    MovingObject::respawn(driverId);
+    road_ = road;
+    nextRoad_ = nullptr;
+    ticksOnRoad_ = 0;
+    asleepSinceTick_ = 0;
+    vehicle_ = std::move(vehicle);
+    accelerationRate_ = accelerationRate;
+    minDistanceToVehicleAhead_ = minDistanceToVehicleAhead;
+    maxSpeedOverLimit_ = maxSpeedOverLimit;
+    roadConditionSpeedModifier_ = roadConditionSpeedModifier;
+}
+
+std::unique_ptr<Vehicle> Driver::releaseVehicle()
+{
+    return std::move(vehicle_);
+}
+
+std::shared_ptr<Road> Driver::getRoad() const
+{
+    return road_;
+}
+
+Vehicle* Driver::getVehicle() const
+{
+    return vehicle_.get();
+}
+
+DriverState Driver::getState() const
+{
+    auto state = DriverState{};
+    state.objectId = objectId_;
+    state.randomCounter = random_.getCounter();
+    state.maxAcceleration = vehicle_->maxAcceleration_;
+    state.maxDeceleration = vehicle_->maxDeceleration_;
+    state.accelerationRate = accelerationRate_;
+    state.minDistanceToVehicleAhead = minDistanceToVehicleAhead_;
+    state.maxSpeedOverLimit = maxSpeedOverLimit_;
+    state.roadConditionSpeedModifier = roadConditionSpeedModifier_;
+
+    state.roadId = road_->getPathId();
+    state.previousRoadId = NO_ROAD;
+    state.nextRoadId = nextRoad_ == nullptr ? NO_ROAD : nextRoad_->getPathId();
+    state.position = position_;
+    state.destinationId = destinationId_;
+    state.despawnOnArrival = despawnOnArrival_;
+    state.distanceTravelled = distanceTravelled_;
+    state.ticksOnRoad = ticksOnRoad_;
+    state.speed = vehicle_->speed_;
+    state.vehicleAhead = NO_VEHICLE;
+    state.vehicleBehind = NO_VEHICLE;
+    state.lane = vehicle_->lane_;
+    state.isLastOnRoad = false;
+    state.asleep = vehicle_->asleep_;
+    state.asleepSinceTick = asleepSinceTick_;
+    return state;
+}
+
+void Driver::restoreState(const DriverState& state, const std::shared_ptr<Road> road)
+{
+    road_ = road;
+    nextRoad_ = nullptr;
+    for(const auto& nextRoad : road_->getJunction()->getOutgoingRoads())
+    {
+        if(state.nextRoadId != NO_ROAD && nextRoad.lock()->getPathId() == state.nextRoadId)
+        {
+            nextRoad_ = nextRoad.lock();
+        }
+    }
+    accelerationRate_ = state.accelerationRate;
+    minDistanceToVehicleAhead_ = state.minDistanceToVehicleAhead;
+    maxSpeedOverLimit_ = state.maxSpeedOverLimit;
+    roadConditionSpeedModifier_ = state.roadConditionSpeedModifier;
+    objectId_ = state.objectId;
+    random_ = common::RandomGenerator{random_.getSeed(), state.objectId, state.randomCounter};
+    position_ = state.position;
+    destinationId_ = state.destinationId;
+    despawnOnArrival_ = state.despawnOnArrival;
+    distanceTravelled_ = state.distanceTravelled;
+    ticksOnRoad_ = state.ticksOnRoad;
+    vehicle_->reset(state.maxAcceleration, state.maxDeceleration);
+    vehicle_->speed_ = state.speed;
+    vehicle_->distanceTravelled_ = state.distanceTravelled;
+}
+
+bool Driver::canSleep() const
+{
+    if(vehicle_->speed_ != 0)
+    {
+        return false;
+    }
+    if(vehicle_->vehicleAhead_ == nullptr)
+    {
+        return distanceTravelled_ == road_->getLength()
+            && !road_->hasGreenLight();
+    }
+    return vehicle_->vehicleAhead_->asleep_ && vehicle_->vehicleAhead_->distanceTravelled_
+        - vehicle_->distanceTravelled_ <= minDistanceToVehicleAhead_;
+}
+
+void Driver::sleep(const uint64_t tick)
+{
+    vehicle_->asleep_ = true;
+    asleepSinceTick_ = tick;
+}
+
+void Driver::wake(const uint64_t tick)
+{
+    vehicle_->asleep_ = false;
+    ticksOnRoad_ += static_cast<uint32_t>(tick - asleepSinceTick_);
+}
+
 void Driver::move()
 {
+    ticksOnRoad_++;
+    changeLane();
     calculateNewSpeed();
     auto step = vehicle_->speed_;
 
     doStep(step);
-    position_ = road_->calculateNewPosition(distanceTravelled_);
+    if(arrived_)
+    {
+        return;
+    }
+    updatePosition();
 }
 
-void Driver::calculateNewSpeed()
+void Driver::updatePosition()
 {
-    if(vehicle_->vehicleAhead_ == nullptr)
+    position_ = road_->isVisible() ? road_->calculateNewPosition(distanceTravelled_)
+        : common::HIDDENPOINT;
+}
+
+void Driver::changeLane()
+{
+    if(road_->getLaneCount() == 1 || vehicle_->speed_ == 0)
+    {
+        return;
+    }
+    const auto gapAhead = [this](const Vehicle* const vehicleAhead)
+        {
+            return vehicleAhead == nullptr ? road_->getLength() - distanceTravelled_
+                : vehicleAhead->distanceTravelled_ - distanceTravelled_;
+        };
+    const auto lane = vehicle_->lane_;
+    const auto currentGap = gapAhead(vehicle_->vehicleAhead_);
+    const auto freeLaneGap = minDistanceToVehicleAhead_ * FREE_LANE_DISTANCE_MULTIPLIER
+        + vehicle_->speed_ * vehicle_->speed_ * SPEED_TO_DISTANCE_MODIFIER
+        / vehicle_->maxDeceleration_;
+
+    /* overtakes slower vehicle using lane on the left */
+    if(lane + 1 < road_->getLaneCount() && vehicle_->vehicleAhead_ != nullptr
+        && vehicle_->vehicleAhead_->speed_ <= vehicle_->speed_ && currentGap < freeLaneGap
+        && canChangeLane(lane + 1)
+        && gapAhead(road_->getNeighbours(lane + 1, distanceTravelled_).first)
+        > currentGap + minDistanceToVehicleAhead_)
     {
-        auto distanceToJunction = road_->getLength() - distanceTravelled_;
-        auto speedDeterminer = vehicle_->speed_ * vehicle_->speed_ * SPEED_TO_DISTANCE_MODIFIER
-            / vehicle_->maxDeceleration_;
+        road_->changeLane(vehicle_.get(), lane + 1);
+        return;
+    }
+    /* goes back to lane on the right when it is free */
+    if(lane > 0 && canChangeLane(lane - 1)
+        && gapAhead(road_->getNeighbours(lane - 1, distanceTravelled_).first)
+        >= std::max(currentGap, freeLaneGap))
+    {
+        road_->changeLane(vehicle_.get(), lane - 1);
+    }
+}
 
-        if(vehicle_->speed_ == 0 && distanceToJunction != 0)
+bool Driver::canChangeLane(const uint32_t lane) const
+{
+    const auto [vehicleAhead, vehicleBehind] = road_->getNeighbours(lane, distanceTravelled_);
+    if(vehicleAhead != nullptr)
+    {
+        auto safeDistance = minDistanceToVehicleAhead_;
+        if(vehicle_->speed_ > vehicleAhead->speed_)
         {
-            accelerate();
-            vehicle_->speed_ = std::min(vehicle_->speed_, distanceToJunction);
+            safeDistance += 2 * (vehicle_->speed_ - vehicleAhead->speed_ + 1) * vehicle_->speed_
+                * SPEED_TO_DISTANCE_MODIFIER / vehicle_->maxDeceleration_;
         }
-
-        if(distanceToJunction > speedDeterminer * 2)
+        if(vehicleAhead->distanceTravelled_ - distanceTravelled_ < safeDistance)
         {
-            accelerate();
-            return;
+            return false;
         }
-        if(road_->getJunction()->isGreenLight(road_->getPathId()))
+    }
+    if(vehicleBehind != nullptr)
+    {
+        auto safeDistance = minDistanceToVehicleAhead_;
+        if(vehicleBehind->speed_ > vehicle_->speed_)
         {
-            if(vehicle_->speed_ < road_->getJunction()->getSpeedLimit())
-            {
-                accelerate();
-                return;
-            }
-            if(vehicle_->speed_ > road_->getJunction()->getSpeedLimit())
-            {
-                decelerate(speedDeterminer, speedDeterminer);
-                return;
-            }
+            safeDistance += 2 * (vehicleBehind->speed_ - vehicle_->speed_ + 1)
+                * vehicleBehind->speed_ * SPEED_TO_DISTANCE_MODIFIER
+                / vehicleBehind->maxDeceleration_;
         }
-        if(distanceToJunction < speedDeterminer)
+        if(distanceTravelled_ - vehicleBehind->distanceTravelled_ < safeDistance)
         {
-            decelerate(speedDeterminer - distanceToJunction, speedDeterminer);
+            return false;
         }
+    }
+    return true;
+}
+
+void Driver::calculateNewSpeed()
+{
+    if(vehicle_->vehicleAhead_ != nullptr)
+    {
+        followVehicle(vehicle_->vehicleAhead_, vehicle_->vehicleAhead_->distanceTravelled_
+            - vehicle_->distanceTravelled_);
         return;
     }
-    auto distanceToVehicle = vehicle_->vehicleAhead_->distanceTravelled_
-        - vehicle_->distanceTravelled_;
+    const auto speed = vehicle_->speed_;
+    const auto distanceToJunction = road_->getLength() - distanceTravelled_;
+    const auto lookAheadDistance = 3 * (speed + 1) * speed * SPEED_TO_DISTANCE_MODIFIER
+        / vehicle_->maxDeceleration_ + minDistanceToVehicleAhead_;
 
-    if(vehicle_->vehicleAhead_->speed_ > vehicle_->speed_
+    approachJunction();
+    if(!road_->hasGreenLight() || distanceToJunction >= lookAheadDistance)
+    {
+        return;
+    }
+    const auto [vehicleAhead, distanceToVehicle] = findVehicleBeyondJunction();
+    if(vehicleAhead == nullptr)
+    {
+        return;
+    }
+    /* slows down for queue behind junction as it would for vehicle ahead on the same road */
+    const auto junctionSpeed = vehicle_->speed_;
+    vehicle_->speed_ = speed;
+    followVehicle(vehicleAhead, distanceToVehicle);
+    vehicle_->speed_ = std::min(vehicle_->speed_, junctionSpeed);
+}
+
+void Driver::approachJunction()
+{
+    auto distanceToJunction = road_->getLength() - distanceTravelled_;
+    auto speedDeterminer = vehicle_->speed_ * vehicle_->speed_ * SPEED_TO_DISTANCE_MODIFIER
+        / vehicle_->maxDeceleration_;
+
+    if(vehicle_->speed_ == 0 && distanceToJunction != 0)
+    {
+        accelerate();
+        vehicle_->speed_ = std::min(vehicle_->speed_, distanceToJunction);
+    }
+
+    if(distanceToJunction > speedDeterminer * 2)
+    {
+        accelerate();
+        return;
+    }
+    if(road_->hasGreenLight())
+    {
+        if(vehicle_->speed_ < road_->getJunction()->getSpeedLimit())
+        {
+            accelerate();
+            return;
+        }
+        if(vehicle_->speed_ > road_->getJunction()->getSpeedLimit())
+        {
+            decelerate(speedDeterminer, speedDeterminer);
+            return;
+        }
+    }
+    if(distanceToJunction < speedDeterminer)
+    {
+        decelerate(speedDeterminer - distanceToJunction, speedDeterminer);
+    }
+}
+
+void Driver::followVehicle(const Vehicle* const vehicleAhead, const uint32_t distanceToVehicle)
+{
+    if(vehicleAhead->speed_ > vehicle_->speed_
        && distanceToVehicle > minDistanceToVehicleAhead_ * 2)
     {
         accelerate();
         return;
     }
-    auto speedDeterminer = (vehicle_->speed_ - vehicle_->vehicleAhead_->speed_ + 1)
+    auto speedDeterminer = (vehicle_->speed_ - vehicleAhead->speed_ + 1)
          * vehicle_->speed_ * SPEED_TO_DISTANCE_MODIFIER / vehicle_->maxDeceleration_;
 
     if(distanceToVehicle > speedDeterminer * 3 + minDistanceToVehicleAhead_)
@@ -98,6 +327,33 @@ void Driver::calculateNewSpeed()
     }
 }
 
+std::pair<const Vehicle*, uint32_t> Driver::findVehicleBeyondJunction()
+{
+    const auto nextRoad = getNextRoad();
+    if(nextRoad == nullptr)
+    {
+        return std::make_pair(nullptr, 0);
+    }
+    auto distanceToVehicle = road_->getLength() - distanceTravelled_;
+    if(!(nextRoad->getStartPoint() == road_->calculateNewPosition(road_->getLength())))
+    {
+        const auto junctionRoad = road_->getJunction()->getJunctionRoad(road_->getPathId(),
+            nextRoad->getPathId());
+        const auto lastVehicle = junctionRoad->getLastVehicle(junctionRoad->getEntryLane());
+        if(lastVehicle != nullptr)
+        {
+            return std::make_pair(lastVehicle, distanceToVehicle + lastVehicle->distanceTravelled_);
+        }
+        distanceToVehicle += junctionRoad->getLength();
+    }
+    const auto lastVehicle = nextRoad->getLastVehicle(nextRoad->getEntryLane());
+    if(lastVehicle == nullptr)
+    {
+        return std::make_pair(nullptr, 0);
+    }
+    return std::make_pair(lastVehicle, distanceToVehicle + lastVehicle->distanceTravelled_);
+}
+
 void Driver::accelerate()
 {
     auto maxSpeed = road_->getSpeedLimit() + maxSpeedOverLimit_;
@@ -145,12 +401,16 @@ void Driver::doStep(uint32_t step)
     {
         distanceTravelled_ += step;
     }
-    else if(road_->getJunction()->isGreenLight(road_->getPathId()))
+    else if(road_->hasGreenLight())
     {
         step = distanceTravelled_ + step - road_->getLength();
         position_ = road_->calculateNewPosition(road_->getLength());
 
         selectNewPath();
+        if(arrived_)
+        {
+            return;
+        }
         doStep(step);
     }
     else
@@ -162,30 +422,27 @@ void Driver::doStep(uint32_t step)
 
 void Driver::selectNewPath()
 {
-    distanceTravelled_ = 0;
-    road_->removeVehicle(vehicle_.get());
-    if(vehicle_->vehicleBehind_ != nullptr)
+    if(road_->getPathId() != DUMMY_ID)
     {
-        vehicle_->vehicleBehind_->vehicleAhead_ = nullptr;
-        vehicle_->vehicleAhead_ = nullptr;
+        road_->recordPassage(ticksOnRoad_);
     }
+    ticksOnRoad_ = 0;
+    distanceTravelled_ = 0;
+    road_->removeVehicle(vehicle_.get());
 
     const auto junction = road_->getJunction();
     if(destinationId_ == junction->getId())
     {
         destinationId_ = NO_DESTINATION;
+        if(despawnOnArrival_)
+        {
+            arrived_ = true;
+            return;
+        }
     }
 
-    auto newRoad = std::shared_ptr<Road>{};
-    if(destinationId_ != NO_DESTINATION)
-    {
-        newRoad = junction->getFastestRoad(destinationId_);
-    }
-    else
-    {
-        auto roads = junction->getOutgoingRoads();
-        newRoad = roads[std::rand() % std::size(roads)].lock();
-    }
+    const auto newRoad = getNextRoad();
+    nextRoad_ = nullptr;
 
     if(newRoad->getStartPoint() == position_)
     {
@@ -198,9 +455,30 @@ void Driver::selectNewPath()
     road_->addVehicle(vehicle_.get());
 }
 
-} // trafficsimulation::model
-
-
-
-
+std::shared_ptr<Road> Driver::getNextRoad()
+{
+    if(nextRoad_ != nullptr)
+    {
+        return nextRoad_;
+    }
+    const auto junction = road_->getJunction();
+    if(destinationId_ == junction->getId() && despawnOnArrival_)
+    {
+        return nullptr;
+    }
+    if(destinationId_ != NO_DESTINATION && destinationId_ != junction->getId())
+    {
+        nextRoad_ = junction->getFastestRoad(destinationId_);
+        if(nextRoad_ != nullptr)
+        {
+            return nextRoad_;
+        }
+        // destination cannot be reached from junction, driver drives randomly
+        destinationId_ = NO_DESTINATION;
+    }
+    auto roads = junction->getOutgoingRoads();
+    nextRoad_ = roads[random_.next() % std::size(roads)].lock();
+    return nextRoad_;
+}
 
+} // trafficsimulation::model
@@ -0,0 +1,149 @@
+#include "../include/model/EnsembleRunner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "../include/model/Simulation.hpp"
+
+namespace trafficsimulation::model
+{
+
+EnsembleRunner::EnsembleRunner(const std::shared_ptr<const Network> network)
+    : network_{network}
+{
+}
+
+EnsembleRunner::~EnsembleRunner() = default;
+
+EnsembleStatistics EnsembleRunner::run(const std::vector<EnsembleMember>& members,
+    const uint64_t ticks, const uint32_t threadCount) const
+{
+    auto statistics = EnsembleStatistics{};
+    statistics.results.resize(std::size(members));
+    statistics.meanTravelTicks = 0;
+
+    auto nextMember = std::atomic<std::size_t>{0};
+    const auto worker = [this, &members, &statistics, &nextMember, ticks]()
+        {
+            for(auto member = nextMember++; member < std::size(members); member = nextMember++)
+            {
+                statistics.results[member] = runMember(members[member], ticks);
+            }
+        };
+
+    auto workerCount = threadCount != 0 ? threadCount
+        : std::max(std::thread::hardware_concurrency(), 1u);
+    workerCount = std::min(workerCount, static_cast<uint32_t>(std::size(members)));
+
+    auto workers = std::vector<std::thread>{};
+    for(auto iterator = uint32_t{0}; iterator < workerCount; ++iterator)
+    {
+        workers.emplace_back(worker);
+    }
+    for(auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    auto succeeded = uint32_t{0};
+    auto passedVehicles = uint64_t{0};
+    auto travelTicks = uint64_t{0};
+    for(const auto& result : statistics.results)
+    {
+        if(result.error.has_value())
+        {
+            continue;
+        }
+        succeeded++;
+        for(const auto& road : result.roadStatistics)
+        {
+            passedVehicles += road.second.passedVehicles;
+            travelTicks += road.second.totalTravelTicks;
+            statistics.meanThroughput[road.first] += road.second.passedVehicles;
+        }
+    }
+    if(succeeded == 0)
+    {
+        return statistics;
+    }
+    if(passedVehicles != 0)
+    {
+        statistics.meanTravelTicks = static_cast<double>(travelTicks)
+            / static_cast<double>(passedVehicles);
+    }
+    for(auto& road : statistics.meanThroughput)
+    {
+        road.second /= succeeded;
+    }
+    return statistics;
+}
+
+EnsembleResult EnsembleRunner::runMember(const EnsembleMember& member,
+    const uint64_t ticks) const
+{
+    auto result = EnsembleResult{};
+    result.seed = member.seed;
+
+    auto simulation = Simulation{member.seed, *network_};
+    if(member.signalController != nullptr)
+    {
+        simulation.setSignalController(member.signalController);
+    }
+    simulation.addDrivers(member.driverCount, member.driverDistribution);
+    simulation.addPedestrians(member.pedestrianCount, DEFAULTPEDESTRIANMAXSPEED);
+
+    result.error = simulation.setDemand(member.demand);
+    if(result.error.has_value())
+    {
+        return result;
+    }
+    for(const auto& corridor : member.corridors)
+    {
+        result.error = simulation.coordinateCorridor(corridor);
+        if(result.error.has_value())
+        {
+            return result;
+        }
+    }
+    if(member.snapshotPainter == nullptr)
+    {
+        result.error = simulation.run(ticks);
+    }
+    else
+    {
+        result.error = runWithSnapshots(simulation, member, ticks);
+    }
+    if(!result.error.has_value())
+    {
+        result.roadStatistics = simulation.getRoadStatistics();
+    }
+    return result;
+}
+
+std::optional<std::string> EnsembleRunner::runWithSnapshots(Simulation& simulation,
+    const EnsembleMember& member, const uint64_t ticks) const
+{
+    // validates simulation before its layout is painted
+    auto result = simulation.run(0);
+    if(result.has_value())
+    {
+        return result;
+    }
+    member.snapshotPainter->setLayout(simulation.captureLayout());
+    member.snapshotPainter->paint(simulation.captureFrame());
+
+    const auto interval = std::max(member.snapshotInterval, uint64_t{1});
+    for(auto tick = uint64_t{0}; tick < ticks; tick += interval)
+    {
+        result = simulation.run(std::min(interval, ticks - tick));
+        if(result.has_value())
+        {
+            return result;
+        }
+        member.snapshotPainter->paint(simulation.captureFrame());
+    }
+    return {};
+}
+
+} // trafficsimulation::model
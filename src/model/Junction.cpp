@@ -1,39 +1,65 @@
 #include "../include/model/Junction.hpp"
 
 #include <algorithm>
-#include <cstdlib>
+#include <cmath>
+#include <cstdint>
 
+#include "../include/common/RandomGenerator.hpp"
 #include "../include/interface/PointPainter.hpp"
+#include "../include/model/Checkpoint.hpp"
 #include "../include/model/Path.hpp"
 #include "../include/model/Road.hpp"
+#include "../include/model/SignalController.hpp"
 
 namespace trafficsimulation::model
 {
 
 constexpr uint32_t PEDESTRIAN_RED_LIGHT_TICKS = 240;
 constexpr uint32_t DRIVER_RED_LIGHT_TICKS = 60;
-constexpr uint32_t DUMMY_ID = 0xFFFF;
-// usual Vehicle will drive through Junction in 100 ticks - 10 sec
+// usual Pedestrian will walk through Junction in 250 ticks - 25 sec
 constexpr uint32_t TEMPORARY_PATH_LENGTH = 20000;
+// junction road is as long as distance between ends of roads it connects
+constexpr float TEMPORARY_ROAD_LENGTH_PER_UNIT = 550;
+constexpr uint32_t TEMPORARY_ROAD_MIN_LENGTH = 10000;
 constexpr uint32_t TEMPORARY_PATH_MAX_SPEED_LIMIT = 300;
 constexpr RoadCondition TEMPORARY_ROAD_CONDITION = RoadCondition::SomePotHoles;
+constexpr uint32_t TEMPORARY_ROAD_LANE_COUNT = 1;
 
-Junction::Junction(const uint32_t junctionId, const common::Point position)
+namespace
+{
+
+uint32_t calculateJunctionRoadLength(const common::Point startPoint, const common::Point endPoint)
+{
+    const auto changeOnX = static_cast<float>(endPoint.x - startPoint.x);
+    const auto changeOnY = static_cast<float>(endPoint.y - startPoint.y);
+    return std::max(TEMPORARY_ROAD_MIN_LENGTH, static_cast<uint32_t>(
+        std::sqrt(changeOnX * changeOnX + changeOnY * changeOnY) * TEMPORARY_ROAD_LENGTH_PER_UNIT));
+}
+
+}
+
+Junction::Junction(const uint32_t junctionId, const common::Point position, const uint64_t seed,
+    const uint64_t tick)
     : junctionId_{junctionId}
     , position_ {position}
     , speedLimit_{TEMPORARY_PATH_MAX_SPEED_LIMIT}
     , incomingRoads_{}
+    , greenLights_{}
     , lightState_{LightState::PedestrianGreenLight}
     , roadWithGreenIterator_{0}
     , timeoutTicks_{0}
-    , ticksToLightChange_{0}
+    , lightStartTick_{tick}
+    , lightChangeTick_{tick}
     , outgoingRoads_{}
     , outgoingPavements_{}
     , junctionRoads_{}
-    , fastestRoutes_{}
+    , fastestRoutes_{nullptr}
+    , signalController_{FIXEDTIMESIGNALCONTROLLER}
+    , painter_{nullptr}
 {
-    timeoutTicks_ = std::rand() * std::rand() % 191 + 260; /* of 260 - 450 ticks -> default 20 - 32 sec*/
-    ticksToLightChange_ = timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS;
+    timeoutTicks_ = common::RandomGenerator{seed, junctionId}.nextInRange(260, 450); /* of 260 - 450 ticks -> default 20 - 32 sec*/
+    lightChangeTick_ += timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS - 1;
+    updateGreenLights();
 }
 
 Junction::~Junction() = default;
@@ -53,26 +79,24 @@ uint32_t Junction::getSpeedLimit() const
     return speedLimit_;
 }
 
-bool Junction::isGreenLight(const uint32_t pathId) const
+uint64_t Junction::getLightChangeTick() const
 {
-    /* is either dummy junction or only pedestrians cross it */
-    if (std::size(incomingRoads_) == 0)
-    {
-        return true;
-    }
-    if (lightState_ == LightState::PedestrianGreenLight
-         && std::find_if(incomingRoads_.begin(), incomingRoads_.end(),
-            [pathId](const std::weak_ptr<Road> road){ return road.lock()->getPathId() == pathId; })
-            == std::cend(incomingRoads_))
-    {
-        return true;
-    }
-    if (lightState_ == LightState::DriverGreenLight
-         && pathId == incomingRoads_[roadWithGreenIterator_].lock()->getPathId())
-    {
-        return true;
-    }
-    return false;
+    return lightChangeTick_;
+}
+
+uint32_t Junction::getCycleTicks() const
+{
+    return 2 * timeoutTicks_ * std::max(getIncomingRoadCount(), uint32_t{1});
+}
+
+uint32_t Junction::getIncomingRoadCount() const
+{
+    return static_cast<uint32_t>(std::size(incomingRoads_));
+}
+
+bool Junction::isGreenLight(const uint32_t lightSlot) const
+{
+    return greenLights_[lightSlot] != 0;
 }
 
 std::vector<std::weak_ptr<Road>> Junction::getOutgoingRoads() const
@@ -91,7 +115,19 @@ std::shared_ptr<Road> Junction::getFastestRoad(const uint32_t destinationId)
     {
         return outgoingRoads_.front().lock();
     }
-    return fastestRoutes_.at(destinationId).first.lock();
+    const auto route = fastestRoutes_->find(destinationId);
+    if(route == std::cend(*fastestRoutes_))
+    {
+        return nullptr;
+    }
+    const auto roadId = route->second.roadId;
+    const auto road = std::find_if(outgoingRoads_.begin(), outgoingRoads_.end(),
+        [roadId](const std::weak_ptr<Road> road){ return road.lock()->getPathId() == roadId; });
+    if(road == std::end(outgoingRoads_))
+    {
+        return nullptr;
+    }
+    return road->lock();
 }
 
 std::shared_ptr<Path> Junction::getFastestPavement(const uint32_t destinationId)
@@ -100,25 +136,41 @@ std::shared_ptr<Path> Junction::getFastestPavement(const uint32_t destinationId)
     {
         return outgoingPavements_.front().lock();
     }
-    return fastestRoutes_.at(destinationId).second.lock();
+    const auto route = fastestRoutes_->find(destinationId);
+    if(route == std::cend(*fastestRoutes_))
+    {
+        return nullptr;
+    }
+    const auto pavementId = route->second.pavementId;
+    const auto pavement = std::find_if(outgoingPavements_.begin(), outgoingPavements_.end(),
+        [pavementId](const std::weak_ptr<Path> pavement)
+        { return pavement.lock()->getPathId() == pavementId; });
+    if(pavement == std::end(outgoingPavements_))
+    {
+        return nullptr;
+    }
+    return pavement->lock();
 }
 
 void Junction::addIncomingRoad(const std::shared_ptr<Road> newRoad)
 {
     incomingRoads_.push_back(std::weak_ptr<Road>{newRoad});
+    newRoad->setLightSlot(static_cast<uint32_t>(std::size(incomingRoads_)));
+    updateGreenLights();
 
     for(const auto& outgoingRoad : outgoingRoads_)
     {
         auto lockedRoad = outgoingRoad.lock();
         auto tempJunction = std::make_shared<Junction>(DUMMY_ID,
-            lockedRoad->getStartPoint());
+            lockedRoad->getStartPoint(), DUMMY_SEED, DUMMY_TICK);
         tempJunction->addOutgoingRoad(lockedRoad);
 
+        const auto startPoint = newRoad->calculateNewPosition(newRoad->getLength());
         junctionRoads_[newRoad->getPathId()][lockedRoad->getPathId()] =
-            std::make_shared<Road>(DUMMY_ID, TEMPORARY_PATH_LENGTH,
-            newRoad->calculateNewPosition(newRoad->getLength()),
-            lockedRoad->getStartPoint(), tempJunction,
-            TEMPORARY_ROAD_CONDITION, speedLimit_);
+            std::make_shared<Road>(DUMMY_ID,
+            calculateJunctionRoadLength(startPoint, lockedRoad->getStartPoint()),
+            startPoint, lockedRoad->getStartPoint(), tempJunction,
+            TEMPORARY_ROAD_CONDITION, speedLimit_, TEMPORARY_ROAD_LANE_COUNT);
     }
 }
 
@@ -130,14 +182,15 @@ void Junction::addOutgoingRoad(const std::shared_ptr<Road> newRoad)
     {
         auto lockedRoad = incomingRoad.lock();
         auto tempJunction = std::make_shared<Junction>(DUMMY_ID,
-            newRoad->getStartPoint());
+            newRoad->getStartPoint(), DUMMY_SEED, DUMMY_TICK);
         tempJunction->addOutgoingRoad(newRoad);
 
+        const auto startPoint = lockedRoad->calculateNewPosition(lockedRoad->getLength());
         junctionRoads_[lockedRoad->getPathId()][newRoad->getPathId()] =
-            std::make_shared<Road>(DUMMY_ID, TEMPORARY_PATH_LENGTH,
-            lockedRoad->calculateNewPosition(lockedRoad->getLength()),
-            newRoad->getStartPoint(), tempJunction,
-            TEMPORARY_ROAD_CONDITION, speedLimit_);
+            std::make_shared<Road>(DUMMY_ID,
+            calculateJunctionRoadLength(startPoint, newRoad->getStartPoint()),
+            startPoint, newRoad->getStartPoint(), tempJunction,
+            TEMPORARY_ROAD_CONDITION, speedLimit_, TEMPORARY_ROAD_LANE_COUNT);
     }
 }
 
@@ -146,10 +199,76 @@ void Junction::addOutgoingPavement(const std::shared_ptr<Path> newPavement)
     outgoingPavements_.push_back(std::weak_ptr<Path>{newPavement});
 }
 
-void Junction::setFastestRoute(const uint32_t destinationId,
-    const std::pair<std::weak_ptr<Road>, std::weak_ptr<Path>> bestPaths)
+void Junction::setFastestRoutes(const std::shared_ptr<const Routes> fastestRoutes)
+{
+    fastestRoutes_ = fastestRoutes;
+}
+
+void Junction::setSignalController(
+    const std::shared_ptr<const SignalController> signalController)
 {
-    fastestRoutes_.emplace(destinationId, bestPaths);
+    signalController_ = signalController;
+}
+
+void Junction::coordinateLights(const uint32_t cycleTicks, const uint32_t roadId,
+    const uint64_t greenStartTick, const uint64_t tick)
+{
+    const auto road = std::find_if(incomingRoads_.cbegin(), incomingRoads_.cend(),
+        [roadId](const std::weak_ptr<Road> road){ return road.lock()->getPathId() == roadId; });
+    if(road == std::cend(incomingRoads_))
+    {
+        return;
+    }
+    const auto roadCount = getIncomingRoadCount();
+    const auto roadIndex = static_cast<uint32_t>(std::distance(incomingRoads_.cbegin(), road));
+    timeoutTicks_ = cycleTicks / (2 * roadCount);
+
+    /* each road gets one round of lights: pedestrian green, pedestrian red, driver green
+     * and driver red, green light of road starts timeoutTicks_ after start of its round */
+    const auto roundTicks = int64_t{2} * timeoutTicks_;
+    const auto lastTick = static_cast<int64_t>(tick) - 1;
+    const auto roundStartTick = static_cast<int64_t>(greenStartTick) - timeoutTicks_;
+    auto position = (lastTick - roundStartTick) % (roundTicks * roadCount);
+    if(position < 0)
+    {
+        position += roundTicks * roadCount;
+    }
+    const auto greenRoad = static_cast<uint32_t>((roadIndex + position / roundTicks) % roadCount);
+    const auto offset = position % roundTicks;
+    const auto currentRoundStartTick = lastTick - offset;
+
+    auto startTick = currentRoundStartTick;
+    auto changeTick = currentRoundStartTick;
+    if(offset < timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS)
+    {
+        lightState_ = LightState::PedestrianGreenLight;
+        roadWithGreenIterator_ = (greenRoad + roadCount - 1) % roadCount;
+        changeTick += timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS;
+    }
+    else if(offset < timeoutTicks_)
+    {
+        lightState_ = LightState::PedestrianRedLight;
+        roadWithGreenIterator_ = (greenRoad + roadCount - 1) % roadCount;
+        startTick += timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS;
+        changeTick += timeoutTicks_;
+    }
+    else if(offset < roundTicks - DRIVER_RED_LIGHT_TICKS)
+    {
+        lightState_ = LightState::DriverGreenLight;
+        roadWithGreenIterator_ = greenRoad;
+        startTick += timeoutTicks_;
+        changeTick += roundTicks - DRIVER_RED_LIGHT_TICKS;
+    }
+    else
+    {
+        lightState_ = LightState::DriverRedLight;
+        roadWithGreenIterator_ = greenRoad;
+        startTick += roundTicks - DRIVER_RED_LIGHT_TICKS;
+        changeTick += roundTicks;
+    }
+    lightStartTick_ = static_cast<uint64_t>(std::max(startTick, int64_t{0}));
+    lightChangeTick_ = static_cast<uint64_t>(changeTick);
+    updateGreenLights();
 }
 
 std::shared_ptr<Road> Junction::getJunctionRoad(const uint32_t oldRoadId, const uint32_t newRoadId) const
@@ -157,11 +276,16 @@ std::shared_ptr<Road> Junction::getJunctionRoad(const uint32_t oldRoadId, const
     return junctionRoads_.at(oldRoadId).at(newRoadId);
 }
 
+const std::map<uint32_t, std::map<uint32_t, std::shared_ptr<Road>>>& Junction::getJunctionRoads() const
+{
+    return junctionRoads_;
+}
+
 std::shared_ptr<Path> Junction::createTemporaryPavement(const common::Point startPoint,
     const std::shared_ptr<Path> newPavement) const
 {
     auto tempJunction = std::make_shared<Junction>(DUMMY_ID,
-        newPavement->getStartPoint());
+        newPavement->getStartPoint(), DUMMY_SEED, DUMMY_TICK);
     tempJunction->addOutgoingPavement(newPavement);
     return std::make_shared<Path>(DUMMY_ID, TEMPORARY_PATH_LENGTH,
         startPoint, newPavement->getStartPoint(), tempJunction);
@@ -173,48 +297,112 @@ void Junction::changeLights()
     {
         case LightState::PedestrianGreenLight:
             lightState_ = LightState::PedestrianRedLight;
-            ticksToLightChange_ = PEDESTRIAN_RED_LIGHT_TICKS;
+            lightStartTick_ = lightChangeTick_;
+            lightChangeTick_ += PEDESTRIAN_RED_LIGHT_TICKS;
             break;
         case LightState::PedestrianRedLight:
-            roadWithGreenIterator_++;
-            if(std::size(incomingRoads_) == roadWithGreenIterator_)
-            {
-                roadWithGreenIterator_ = 0;
-            }
+        {
+            const auto phase = signalController_->selectPhase(getQueueLengths(),
+                roadWithGreenIterator_, timeoutTicks_ - DRIVER_RED_LIGHT_TICKS);
+            roadWithGreenIterator_ = phase.greenRoad;
             lightState_ = LightState::DriverGreenLight;
-            ticksToLightChange_ = timeoutTicks_ - DRIVER_RED_LIGHT_TICKS;
+            lightStartTick_ = lightChangeTick_;
+            lightChangeTick_ += std::max(phase.greenTicks, uint32_t{1});
             break;
+        }
         case LightState::DriverGreenLight:
+        {
+            const auto greenTicks = static_cast<uint32_t>(lightChangeTick_ - lightStartTick_);
+            const auto extension = signalController_->extendGreen(getQueueLengths(),
+                roadWithGreenIterator_, greenTicks);
+            if(extension != 0)
+            {
+                lightChangeTick_ += extension;
+                return;
+            }
             lightState_ = LightState::DriverRedLight;
-            ticksToLightChange_ = DRIVER_RED_LIGHT_TICKS;
+            lightStartTick_ = lightChangeTick_;
+            lightChangeTick_ += DRIVER_RED_LIGHT_TICKS;
             break;
+        }
         case LightState::DriverRedLight:
             lightState_ = LightState::PedestrianGreenLight;
-            ticksToLightChange_ = timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS;
+            lightStartTick_ = lightChangeTick_;
+            lightChangeTick_ += timeoutTicks_ - PEDESTRIAN_RED_LIGHT_TICKS;
             break;
     }
+    updateGreenLights();
 }
 
-void Junction::setPainter(interface::PointPainter* const painter)
+std::vector<uint32_t> Junction::getQueueLengths() const
 {
-    painter_ = painter;
-    painter_->setPoint(position_);
+    auto queueLengths = std::vector<uint32_t>{};
+    queueLengths.reserve(std::size(incomingRoads_));
+    for(const auto& road : incomingRoads_)
+    {
+        queueLengths.push_back(road.lock()->getVehicleCount());
+    }
+    return queueLengths;
 }
 
-void Junction::update()
+void Junction::updateGreenLights()
 {
-    ticksToLightChange_--;
-    if(ticksToLightChange_ == 0)
+    greenLights_.assign(std::size(incomingRoads_) + 1, 0);
+
+    /* is either dummy junction or only pedestrians cross it */
+    if(std::size(incomingRoads_) == 0)
+    {
+        greenLights_[OTHER_PATHS_LIGHT_SLOT] = 1;
+        return;
+    }
+    if(lightState_ == LightState::PedestrianGreenLight)
+    {
+        greenLights_[OTHER_PATHS_LIGHT_SLOT] = 1;
+    }
+    if(lightState_ == LightState::DriverGreenLight
+        && roadWithGreenIterator_ < std::size(incomingRoads_))
     {
-        changeLights();
+        greenLights_[roadWithGreenIterator_ + 1] = 1;
     }
+}
 
+JunctionState Junction::getState() const
+{
+    auto state = JunctionState{};
+    state.junctionId = junctionId_;
+    state.position = position_;
+    state.lightState = lightState_;
+    state.roadWithGreenIterator = roadWithGreenIterator_;
+    state.timeoutTicks = timeoutTicks_;
+    state.lightStartTick = lightStartTick_;
+    state.lightChangeTick = lightChangeTick_;
+    return state;
+}
+
+void Junction::restoreState(const JunctionState& state)
+{
+    lightState_ = state.lightState;
+    roadWithGreenIterator_ = state.roadWithGreenIterator;
+    timeoutTicks_ = state.timeoutTicks;
+    lightStartTick_ = state.lightStartTick;
+    lightChangeTick_ = state.lightChangeTick;
+    updateGreenLights();
+}
+
+void Junction::setPainter(interface::PointPainter* const painter)
+{
+    painter_ = painter;
     if(painter_ == nullptr)
     {
-        // add log
         return;
     }
+    painter_->setPoint(position_);
     painter_->paint();
 }
 
+void Junction::update()
+{
+    changeLights();
+}
+
 } // trafficsimulation::model
@@ -5,10 +5,14 @@
 namespace trafficsimulation::model
 {
 
-MovingObject::MovingObject()
-    : position_{common::Point{}}
+MovingObject::MovingObject(const uint32_t objectId, const uint64_t seed)
+    : objectId_{objectId}
+    , position_{common::Point{}}
     , destinationId_{NO_DESTINATION}
     , distanceTravelled_{0}
+    , despawnOnArrival_{false}
+    , arrived_{false}
+    , random_{seed, objectId}
     , painter_{nullptr}
 {
     position_.x = 0xFF;
@@ -17,11 +21,45 @@ MovingObject::MovingObject()
 
 MovingObject::~MovingObject() = default;
 
+void MovingObject::respawn(const uint32_t objectId)
+{
+    objectId_ = objectId;
+    position_.x = 0xFF;
+    position_.y = 0xFF;
+    destinationId_ = NO_DESTINATION;
+    distanceTravelled_ = 0;
+    despawnOnArrival_ = false;
+    arrived_ = false;
+    random_ = common::RandomGenerator{random_.getSeed(), objectId};
+    painter_ = nullptr;
+}
+
+uint32_t MovingObject::getId() const
+{
+    return objectId_;
+}
+
+common::Point MovingObject::getPosition() const
+{
+    return position_;
+}
+
 void MovingObject::setDestination(const uint32_t newDestinationId)
 {
     destinationId_ = newDestinationId;
 }
 
+void MovingObject::setDestination(const uint32_t newDestinationId, const bool despawnOnArrival)
+{
+    destinationId_ = newDestinationId;
+    despawnOnArrival_ = despawnOnArrival;
+}
+
+bool MovingObject::hasArrived() const
+{
+    return arrived_;
+}
+
 void MovingObject::setPainter(interface::PointPainter* const painter)
 {
     painter_ = painter;
@@ -30,7 +68,7 @@ void MovingObject::setPainter(interface::PointPainter* const painter)
 void MovingObject::update()
 {
     move();
-    if(painter_ == nullptr)
+    if(painter_ == nullptr || position_ == common::HIDDENPOINT)
     {
         // add log
         return;
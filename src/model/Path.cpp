@@ -12,9 +12,11 @@ Path::Path(const uint32_t pathId, const uint32_t length, const common::Point sta
     , length_{length}
     , startPoint_{startPoint}
     , endPoint_{endPoint}
-    , shiftOfStartPoint_{common::Point{static_cast<int16_t>(endPoint_.x - startPoint_.x),
-        static_cast<int16_t>(endPoint_.y - startPoint_.y)}}
+    , shiftOfStartPoint_{common::Point{endPoint_.x - startPoint_.x, endPoint_.y - startPoint_.y}}
     , endJunction_{endJunction}
+    , lightSlot_{OTHER_PATHS_LIGHT_SLOT}
+    , visible_{true}
+    , painter_{nullptr}
 {
 }
 
@@ -35,11 +37,36 @@ common::Point Path::getStartPoint() const
     return startPoint_;
 }
 
+common::Point Path::getEndPoint() const
+{
+    return endPoint_;
+}
+
 std::shared_ptr<Junction> Path::getJunction() const
 {
     return endJunction_;
 }
 
+void Path::setLightSlot(const uint32_t lightSlot)
+{
+    lightSlot_ = lightSlot;
+}
+
+bool Path::hasGreenLight() const
+{
+    return endJunction_->isGreenLight(lightSlot_);
+}
+
+void Path::setVisible(const bool visible)
+{
+    visible_ = visible;
+}
+
+bool Path::isVisible() const
+{
+    return visible_;
+}
+
 common::Point Path::calculateNewPosition(uint32_t distanceTravelled) const
 {
     auto partTravelled = static_cast<float>(distanceTravelled) / static_cast<float>(length_);
@@ -53,6 +80,10 @@ common::Point Path::calculateNewPosition(uint32_t distanceTravelled) const
 void Path::setPainter(interface::LinePainter* const painter)
 {
     painter_ = painter;
+    if(painter_ == nullptr)
+    {
+        return;
+    }
     painter_->setPoints(startPoint_, endPoint_);
 }
 
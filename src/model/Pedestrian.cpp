@@ -1,16 +1,15 @@
 #include "../include/model/Pedestrian.hpp"
 
-#include <cstdlib>
-#include <ctime>
-
+#include "../include/model/Checkpoint.hpp"
 #include "../include/model/Junction.hpp"
 #include "../include/model/Path.hpp"
 
 namespace trafficsimulation::model
 {
 
-Pedestrian::Pedestrian(const std::shared_ptr<Path> pavement, const uint32_t maxSpeed)
-    : MovingObject{}
+Pedestrian::Pedestrian(const uint32_t pedestrianId, const uint64_t seed,
+    const std::shared_ptr<Path> pavement, const uint32_t maxSpeed)
+    : MovingObject{pedestrianId, seed}
     , pavement_{pavement}
     , maxSpeed_{maxSpeed}
 {
@@ -18,12 +17,58 @@ Pedestrian::Pedestrian(const std::shared_ptr<Path> pavement, const uint32_t maxS
 
 Pedestrian::~Pedestrian() = default;
 
+void Pedestrian::respawn(const uint32_t pedestrianId, const std::shared_ptr<Path> pavement,
+    const uint32_t maxSpeed)
+{
+    MovingObject::respawn(pedestrianId);
+    pavement_ = pavement;
+    maxSpeed_ = maxSpeed;
+}
+
+std::shared_ptr<Path> Pedestrian::getPavement() const
+{
+    return pavement_;
+}
+
+PedestrianState Pedestrian::getState() const
+{
+    auto state = PedestrianState{};
+    state.objectId = objectId_;
+    state.randomCounter = random_.getCounter();
+    state.maxSpeed = maxSpeed_;
+    state.pavementId = pavement_->getPathId();
+    state.onTemporaryPavement = false;
+    state.temporaryStartPoint = common::Point{};
+    state.position = position_;
+    state.destinationId = destinationId_;
+    state.despawnOnArrival = despawnOnArrival_;
+    state.distanceTravelled = distanceTravelled_;
+    return state;
+}
+
+void Pedestrian::restoreState(const PedestrianState& state, const std::shared_ptr<Path> pavement)
+{
+    pavement_ = pavement;
+    maxSpeed_ = state.maxSpeed;
+    objectId_ = state.objectId;
+    random_ = common::RandomGenerator{random_.getSeed(), state.objectId, state.randomCounter};
+    position_ = state.position;
+    destinationId_ = state.destinationId;
+    despawnOnArrival_ = state.despawnOnArrival;
+    distanceTravelled_ = state.distanceTravelled;
+}
+
 void Pedestrian::move()
 {
-    auto step = maxSpeed_ - std::rand() % (maxSpeed_ / 3);
+    auto step = maxSpeed_ - random_.next() % (maxSpeed_ / 3);
 
     doStep(step);
-    position_ = pavement_->calculateNewPosition(distanceTravelled_);
+    if(arrived_)
+    {
+        return;
+    }
+    position_ = pavement_->isVisible() ? pavement_->calculateNewPosition(distanceTravelled_)
+        : common::HIDDENPOINT;
 }
 
 void Pedestrian::doStep(uint32_t step)
@@ -33,12 +78,16 @@ void Pedestrian::doStep(uint32_t step)
         distanceTravelled_ += step;
         return;
     }
-    if(pavement_->getJunction()->isGreenLight(pavement_->getPathId()))
+    if(pavement_->hasGreenLight())
     {
         step = distanceTravelled_ + step - pavement_->getLength();
         position_ = pavement_->calculateNewPosition(pavement_->getLength());
 
         selectNewPath();
+        if(arrived_)
+        {
+            return;
+        }
         doStep(step);
         return;
     }
@@ -53,6 +102,11 @@ void Pedestrian::selectNewPath()
     if(destinationId_ == junction->getId())
     {
         destinationId_ = NO_DESTINATION;
+        if(despawnOnArrival_)
+        {
+            arrived_ = true;
+            return;
+        }
     }
 
     auto newPavement = std::shared_ptr<Path>{};
@@ -60,10 +114,12 @@ void Pedestrian::selectNewPath()
     {
         newPavement = junction->getFastestPavement(destinationId_);
     }
-    else
+    if(newPavement == nullptr)
     {
+        // no destination or destination cannot be reached from junction
+        destinationId_ = NO_DESTINATION;
         const auto& pavements = junction->getOutgoingPavements();
-        newPavement = pavements[std::rand() % std::size(pavements)].lock();
+        newPavement = pavements[random_.next() % std::size(pavements)].lock();
     }
 
     if(newPavement->getStartPoint() == position_)
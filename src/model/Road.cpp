@@ -1,17 +1,73 @@
 #include "../include/model/Road.hpp"
 
+#include <algorithm>
+
 #include "../include/model/Vehicle.hpp"
 
 namespace trafficsimulation::model
 {
 
+/* length of lane taken by one vehicle in jam, 7 m */
+constexpr auto JAMVEHICLESPACING = uint32_t{7000};
+
+namespace
+{
+
+void insertVehicle(VehicleQueue& vehicles, Vehicle* const vehicleBehind, Vehicle* const vehicle)
+{
+    const auto vehicleAhead = vehicleBehind == nullptr ? vehicles.getLast()
+        : vehicleBehind->getVehicleAhead();
+
+    vehicle->setVehicleAhead(vehicleAhead);
+    vehicle->setVehicleBehind(vehicleBehind);
+    if(vehicleAhead != nullptr)
+    {
+        vehicleAhead->setVehicleBehind(vehicle);
+    }
+    if(vehicleBehind != nullptr)
+    {
+        vehicleBehind->setVehicleAhead(vehicle);
+    }
+    vehicles.insert(vehicleBehind, vehicle);
+}
+
+void appendVehicles(VehicleQueue& vehicles, std::vector<Vehicle*>::const_iterator begin,
+    const std::vector<Vehicle*>::const_iterator end)
+{
+    vehicles.reserve(static_cast<std::size_t>(end - begin));
+    auto vehicleAhead = vehicles.getLast();
+    for(; begin != end; ++begin)
+    {
+        const auto vehicle = *begin;
+        if(vehicleAhead != nullptr
+            && vehicle->getDistanceTravelled() > vehicleAhead->getDistanceTravelled())
+        {
+            // vehicle is ahead of last vehicle that was on lane before, keeps lane sorted
+            insertVehicle(vehicles, vehicles.findPlace(vehicle->getDistanceTravelled()), vehicle);
+            continue;
+        }
+        vehicle->setVehicleAhead(vehicleAhead);
+        vehicle->setVehicleBehind(nullptr);
+        if(vehicleAhead != nullptr)
+        {
+            vehicleAhead->setVehicleBehind(vehicle);
+        }
+        vehicles.pushBack(vehicle);
+        vehicleAhead = vehicle;
+    }
+}
+
+}
+
 Road::Road(const uint32_t pathId, const uint32_t length, const common::Point startPoint,
     const common::Point endPoint, const std::shared_ptr<Junction> endJunction,
-    const RoadCondition roadCondition, const uint32_t speedLimit)
+    const RoadCondition roadCondition, const uint32_t speedLimit, const uint32_t laneCount)
     : Path{pathId, length, startPoint, endPoint, endJunction}
     , roadCondition_{roadCondition}
     , speedLimit_{speedLimit}
-    , lastVehicle_{nullptr}
+    , lanes_(std::max(laneCount, uint32_t{1}))
+    , statistics_{0, 0}
+    , sleepingQueueChanged_{false}
 {
 }
 
@@ -27,22 +83,167 @@ uint32_t Road::getSpeedLimit() const
     return speedLimit_;
 }
 
+uint32_t Road::getLaneCount() const
+{
+    return static_cast<uint32_t>(std::size(lanes_));
+}
+
 void Road::addVehicle(Vehicle* const newLastVehicle)
 {
-    if(lastVehicle_ != nullptr)
+    const auto lane = getEntryLane();
+    auto& vehicles = lanes_[lane];
+    newLastVehicle->setLane(lane);
+    insertVehicle(vehicles, nullptr, newLastVehicle);
+}
+
+void Road::addVehicles(const std::vector<Vehicle*>& newVehicles)
+{
+    const auto entryLane = getEntryLane();
+    auto vehicles = newVehicles;
+    for(auto iterator = std::size_t{0}; iterator < std::size(vehicles); ++iterator)
+    {
+        vehicles[iterator]->setLane(
+            static_cast<uint32_t>((entryLane + iterator) % std::size(lanes_)));
+    }
+    /* lanes are filled from first to last vehicle, ties keep order of newVehicles */
+    std::stable_sort(vehicles.begin(), vehicles.end(),
+        [](const Vehicle* const first, const Vehicle* const second)
+        {
+            return first->getLane() < second->getLane() || (first->getLane() == second->getLane()
+                && first->getDistanceTravelled() > second->getDistanceTravelled());
+        });
+
+    for(auto begin = vehicles.cbegin(); begin != vehicles.cend();)
     {
-        lastVehicle_->setVehicleBehind(newLastVehicle);
+        const auto lane = (*begin)->getLane();
+        const auto end = std::find_if(begin, vehicles.cend(),
+            [lane](const Vehicle* const vehicle){ return vehicle->getLane() != lane; });
+        appendVehicles(lanes_[lane], begin, end);
+        begin = end;
     }
-    newLastVehicle->setVehicleAhead(lastVehicle_);
-    lastVehicle_ = newLastVehicle;
 }
 
 void Road::removeVehicle(Vehicle* const removedVehicle)
 {
-    if(lastVehicle_ == removedVehicle)
+    if(!lanes_[removedVehicle->getLane()].erase(removedVehicle))
+    {
+        return;
+    }
+    const auto vehicleAhead = removedVehicle->getVehicleAhead();
+    const auto vehicleBehind = removedVehicle->getVehicleBehind();
+    if(vehicleAhead != nullptr)
+    {
+        vehicleAhead->setVehicleBehind(vehicleBehind);
+    }
+    if(vehicleBehind != nullptr)
+    {
+        vehicleBehind->setVehicleAhead(vehicleAhead);
+        sleepingQueueChanged_ = sleepingQueueChanged_ || vehicleBehind->isAsleep();
+    }
+    removedVehicle->setVehicleAhead(nullptr);
+    removedVehicle->setVehicleBehind(nullptr);
+}
+
+void Road::changeLane(Vehicle* const vehicle, const uint32_t lane)
+{
+    removeVehicle(vehicle);
+
+    auto& vehicles = lanes_[lane];
+    vehicle->setLane(lane);
+    const auto vehicleBehind = vehicles.findPlace(vehicle->getDistanceTravelled());
+    insertVehicle(vehicles, vehicleBehind, vehicle);
+    sleepingQueueChanged_ = sleepingQueueChanged_
+        || (vehicleBehind != nullptr && vehicleBehind->isAsleep());
+}
+
+std::pair<Vehicle*, Vehicle*> Road::getNeighbours(const uint32_t lane,
+    const uint32_t distanceTravelled) const
+{
+    const auto& vehicles = lanes_[lane];
+    const auto vehicleBehind = vehicles.findPlace(distanceTravelled);
+    return std::make_pair(vehicleBehind == nullptr ? vehicles.getLast()
+        : vehicleBehind->getVehicleAhead(), vehicleBehind);
+}
+
+uint32_t Road::getEntryLane() const
+{
+    auto entryLane = uint32_t{0};
+    for(auto lane = uint32_t{1}; lane < getLaneCount(); ++lane)
     {
-        lastVehicle_ = nullptr;
+        const auto& vehicles = lanes_[lane];
+        const auto& entryVehicles = lanes_[entryLane];
+        if(entryVehicles.isEmpty())
+        {
+            break;
+        }
+        if(vehicles.isEmpty()
+            || vehicles.getLast()->getDistanceTravelled() > entryVehicles.getLast()->getDistanceTravelled()
+            || (vehicles.getLast()->getDistanceTravelled() == entryVehicles.getLast()->getDistanceTravelled()
+            && vehicles.getSize() < entryVehicles.getSize()))
+        {
+            entryLane = lane;
+        }
     }
+    return entryLane;
+}
+
+Vehicle* Road::getLastVehicle(const uint32_t lane) const
+{
+    return lanes_[lane].getLast();
+}
+
+uint32_t Road::getVehicleCount() const
+{
+    auto vehicleCount = uint32_t{0};
+    for(const auto& vehicles : lanes_)
+    {
+        vehicleCount += static_cast<uint32_t>(vehicles.getSize());
+    }
+    return vehicleCount;
+}
+
+float Road::getOccupancy() const
+{
+    return static_cast<float>(getVehicleCount() * JAMVEHICLESPACING)
+        / (static_cast<float>(getLength()) * static_cast<float>(std::size(lanes_)));
+}
+
+void Road::clearVehicles()
+{
+    for(auto& vehicles : lanes_)
+    {
+        vehicles.clear();
+    }
+    sleepingQueueChanged_ = false;
+}
+
+void Road::restoreLane(const uint32_t lane, const std::vector<Vehicle*>& vehicles)
+{
+    auto& laneVehicles = lanes_[lane];
+    laneVehicles.clear();
+    for(const auto vehicle : vehicles)
+    {
+        vehicle->setLane(lane);
+    }
+    appendVehicles(laneVehicles, vehicles.cbegin(), vehicles.cend());
+}
+
+void Road::recordPassage(const uint32_t travelTicks)
+{
+    statistics_.passedVehicles++;
+    statistics_.totalTravelTicks += travelTicks;
+}
+
+bool Road::takeSleepingQueueChange()
+{
+    const auto sleepingQueueChanged = sleepingQueueChanged_;
+    sleepingQueueChanged_ = false;
+    return sleepingQueueChanged;
+}
+
+RoadStatistics Road::getStatistics() const
+{
+    return statistics_;
 }
 
 } // trafficsimulation::model
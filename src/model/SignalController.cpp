@@ -0,0 +1,101 @@
+#include "../include/model/SignalController.hpp"
+
+#include <algorithm>
+
+namespace trafficsimulation::model
+{
+
+namespace
+{
+
+uint32_t nextRoad(const std::vector<uint32_t>& queueLengths, const uint32_t road)
+{
+    if(std::size(queueLengths) == 0)
+    {
+        return 0;
+    }
+    return (road + 1) % static_cast<uint32_t>(std::size(queueLengths));
+}
+
+}
+
+FixedTimeSignalController::FixedTimeSignalController() = default;
+
+FixedTimeSignalController::~FixedTimeSignalController() = default;
+
+SignalPhase FixedTimeSignalController::selectPhase(const std::vector<uint32_t>& queueLengths,
+    const uint32_t lastGreenRoad, const uint32_t defaultGreenTicks) const
+{
+    return SignalPhase{nextRoad(queueLengths, lastGreenRoad), defaultGreenTicks};
+}
+
+uint32_t FixedTimeSignalController::extendGreen(const std::vector<uint32_t>& /* queueLengths */,
+    const uint32_t /* greenRoad */, const uint32_t /* greenTicks */) const
+{
+    return 0;
+}
+
+MaxPressureSignalController::MaxPressureSignalController() = default;
+
+MaxPressureSignalController::~MaxPressureSignalController() = default;
+
+SignalPhase MaxPressureSignalController::selectPhase(const std::vector<uint32_t>& queueLengths,
+    const uint32_t lastGreenRoad, const uint32_t defaultGreenTicks) const
+{
+    auto greenRoad = nextRoad(queueLengths, lastGreenRoad);
+    auto road = greenRoad;
+    for(auto iterator = std::size_t{1}; iterator < std::size(queueLengths); ++iterator)
+    {
+        road = nextRoad(queueLengths, road);
+        if(queueLengths[road] > queueLengths[greenRoad])
+        {
+            greenRoad = road;
+        }
+    }
+    return SignalPhase{greenRoad, defaultGreenTicks};
+}
+
+uint32_t MaxPressureSignalController::extendGreen(
+    const std::vector<uint32_t>& /* queueLengths */, const uint32_t /* greenRoad */,
+    const uint32_t /* greenTicks */) const
+{
+    return 0;
+}
+
+ActuatedSignalController::ActuatedSignalController(const uint32_t minGreenTicks,
+    const uint32_t maxGreenTicks, const uint32_t extensionTicks)
+    : minGreenTicks_{std::max(minGreenTicks, uint32_t{1})}
+    , maxGreenTicks_{std::max(maxGreenTicks, minGreenTicks_)}
+    , extensionTicks_{std::max(extensionTicks, uint32_t{1})}
+{
+}
+
+ActuatedSignalController::~ActuatedSignalController() = default;
+
+SignalPhase ActuatedSignalController::selectPhase(const std::vector<uint32_t>& queueLengths,
+    const uint32_t lastGreenRoad, const uint32_t /* defaultGreenTicks */) const
+{
+    auto road = lastGreenRoad;
+    for(auto iterator = std::size_t{0}; iterator < std::size(queueLengths); ++iterator)
+    {
+        road = nextRoad(queueLengths, road);
+        if(queueLengths[road] != 0)
+        {
+            return SignalPhase{road, minGreenTicks_};
+        }
+    }
+    return SignalPhase{nextRoad(queueLengths, lastGreenRoad), minGreenTicks_};
+}
+
+uint32_t ActuatedSignalController::extendGreen(const std::vector<uint32_t>& queueLengths,
+    const uint32_t greenRoad, const uint32_t greenTicks) const
+{
+    if(greenRoad >= std::size(queueLengths) || queueLengths[greenRoad] == 0
+        || greenTicks >= maxGreenTicks_)
+    {
+        return 0;
+    }
+    return std::min(extensionTicks_, maxGreenTicks_ - greenTicks);
+}
+
+} // trafficsimulation::model
@@ -1,17 +1,28 @@
 #include "../include/model/Simulation.hpp"
 
-#include <cstdlib>
+#include <algorithm>
+#include <chrono>
 #include <ctime>
+#include <numeric>
 #include <queue>
+#include <unordered_map>
 
+#include <QTimer>
+
+#include "../include/common/Frame.hpp"
+#include "../include/interface/DensityPainter.hpp"
 #include "../include/interface/LinePainter.hpp"
 #include "../include/interface/PointPainter.hpp"
 
+#include "../include/model/Checkpoint.hpp"
 #include "../include/model/Driver.hpp"
 #include "../include/model/Junction.hpp"
+#include "../include/model/Network.hpp"
 #include "../include/model/Path.hpp"
 #include "../include/model/Pedestrian.hpp"
 #include "../include/model/Road.hpp"
+#include "../include/model/SignalController.hpp"
+#include "../include/model/TrajectoryRecorder.hpp"
 #include "../include/model/Vehicle.hpp"
 
 namespace trafficsimulation::model
@@ -20,31 +31,193 @@ namespace trafficsimulation::model
 constexpr auto ROADOFFSET = uint32_t{3};
 constexpr auto PAVEMENTOFFSET = uint32_t{8};
 constexpr auto SPAWNPATHSLENGTH = uint32_t{50000};
+constexpr auto SPAWNROADLANECOUNT = uint32_t{1};
 constexpr auto BASESTARTPOINT = common::Point{-50, -50};
 constexpr auto BASEENDPOINT = common::Point{20, 20};
+/* stream of simulation itself, ids of junctions and moving objects never reach 0 */
+constexpr auto SIMULATIONSTREAMID = uint32_t{0x0000};
+/* distance last vehicle on road has to travel before next one is spawned behind it */
+constexpr auto SOURCEGAP = uint32_t{10000};
+/* paths this close to visible area are visible, so objects entering it are not cut */
+constexpr auto VISIBLEAREAMARGIN = int32_t{20};
+/* painters are moved at about 60 frames per second even if engine ticks slower */
+constexpr auto REFRESHINTERVAL = uint32_t{16};
+
+namespace
+{
+
+constexpr uint64_t packPoint(const common::Point point)
+{
+    return static_cast<uint64_t>(static_cast<uint32_t>(point.x))
+        | static_cast<uint64_t>(static_cast<uint32_t>(point.y)) << 32;
+}
+
+constexpr auto WORLDTOPLEFT = packPoint(common::Point{INT32_MIN, INT32_MIN});
+constexpr auto WORLDBOTTOMRIGHT = packPoint(common::Point{INT32_MAX, INT32_MAX});
+
+common::Point unpackPoint(const uint64_t point)
+{
+    return common::Point{static_cast<int32_t>(static_cast<uint32_t>(point)),
+        static_cast<int32_t>(static_cast<uint32_t>(point >> 32))};
+}
+
+common::Point interpolate(const common::Point previousPoint, const common::Point point,
+    const float progress)
+{
+    if(previousPoint == common::HIDDENPOINT || point == common::HIDDENPOINT)
+    {
+        return point;
+    }
+    return common::Point{
+        previousPoint.x + static_cast<int32_t>(static_cast<float>(point.x - previousPoint.x) * progress),
+        previousPoint.y + static_cast<int32_t>(static_cast<float>(point.y - previousPoint.y) * progress)};
+}
+
+void takePositions(std::unordered_map<uint32_t, PaintedObject>& paintedObjects,
+    const uint64_t tick, const std::vector<common::Point>& points,
+    const std::vector<uint32_t>& ids)
+{
+    if(paintedObjects.empty())
+    {
+        return;
+    }
+    for(auto& paintedObject : paintedObjects)
+    {
+        paintedObject.second.previousPoint = paintedObject.second.point;
+        paintedObject.second.point = common::HIDDENPOINT;
+    }
+    for(auto iterator = std::size_t{0}; iterator < std::size(ids); ++iterator)
+    {
+        const auto paintedObject = paintedObjects.find(ids[iterator]);
+        if(paintedObject != std::end(paintedObjects))
+        {
+            paintedObject->second.tick = tick;
+            paintedObject->second.point = points[iterator];
+        }
+    }
+    /* every object is in each frame, object missing in frame made after it was seen is gone */
+    for(auto paintedObject = paintedObjects.begin(); paintedObject != paintedObjects.end();)
+    {
+        if(paintedObject->second.tick >= tick)
+        {
+            ++paintedObject;
+            continue;
+        }
+        paintedObject->second.painter->release();
+        paintedObject = paintedObjects.erase(paintedObject);
+    }
+}
+
+void paintAgents(const std::unordered_map<uint32_t, PaintedObject>& paintedObjects,
+    const float progress)
+{
+    for(const auto& paintedObject : paintedObjects)
+    {
+        const auto& object = paintedObject.second;
+        object.painter->setPoint(interpolate(object.previousPoint, object.point, progress));
+        object.painter->paint();
+    }
+}
+
+bool isInArea(const Path& path, const common::Point topLeft, const common::Point bottomRight)
+{
+    const auto startPoint = path.getStartPoint();
+    const auto endPoint = path.getEndPoint();
+    return std::max(startPoint.x, endPoint.x) + VISIBLEAREAMARGIN >= topLeft.x
+        && std::min(startPoint.x, endPoint.x) - VISIBLEAREAMARGIN <= bottomRight.x
+        && std::max(startPoint.y, endPoint.y) + VISIBLEAREAMARGIN >= topLeft.y
+        && std::min(startPoint.y, endPoint.y) - VISIBLEAREAMARGIN <= bottomRight.y;
+}
+
+}
 
 Simulation::Simulation()
-    : junctionId_{0x1000}
+    : Simulation{static_cast<uint64_t>(std::time(0))}
+{
+}
+
+Simulation::Simulation(const uint64_t seed)
+    : seed_{seed}
+    , junctionId_{0x1000}
     , pathId_{0x2000}
+    , movingObjectId_{0x10000}
+    , random_{seed, SIMULATIONSTREAMID}
+    , driverDistribution_{DEFAULTDRIVERDISTRIBUTION}
     , junctions_{}
     , drivers_{}
     , pedestrians_{}
+    , sleepingDrivers_{}
+    , freeDrivers_{}
+    , freePedestrians_{}
+    , freeVehicles_{}
     , roadConnections_{}
     , pavementConnections_{}
     , spawnRoad_{nullptr}
     , spawnPavement_{nullptr}
+    , fastestRoutes_{}
+    , signalController_{FIXEDTIMESIGNALCONTROLLER}
+    , demand_{}
+    , waitingDrivers_{}
+    , tick_{0}
+    , lightTimers_{0}
+    , recorder_{nullptr}
+    , driverPainters_{}
+    , pedestrianPainters_{}
+    , densityPainter_{nullptr}
+    , frames_{}
+    , currentFrame_{}
+    , currentFrameTime_{}
+    , tickInterval_{0}
+    , engineRunning_{false}
+    , pendingDestinationId_{NO_DESTINATION}
+    , visibleAreaVersion_{0}
+    , visibleTopLeft_{WORLDTOPLEFT}
+    , visibleBottomRight_{WORLDBOTTOMRIGHT}
+    , appliedTopLeft_{WORLDTOPLEFT}
+    , appliedBottomRight_{WORLDBOTTOMRIGHT}
+    , engine_{}
     , simulationRefreshTimer_{nullptr}
     , basePrintersSet_{false}
 {
-    std::srand(std::time(0));
     generateBaseSimulation();
+}
 
-    auto timer = new QTimer();
-    connect(timer, &QTimer::timeout, this, &Simulation::updateObjects);
-    simulationRefreshTimer_ = std::unique_ptr<QTimer>(timer);
+Simulation::Simulation(const uint64_t seed, const Network& network)
+    : Simulation{seed}
+{
+    /* first junction is created by simulation itself */
+    for(auto iterator = std::size_t{1}; iterator < std::size(network.junctions); ++iterator)
+    {
+        addJunction(network.junctions[iterator], nullptr);
+    }
+    auto junctions = std::map<uint32_t, std::shared_ptr<Junction>>{};
+    for(const auto& junction : junctions_)
+    {
+        junctions[junction->getId()] = junction;
+    }
+    for(const auto& path : network.paths)
+    {
+        if(path.pathType == PathType::Road)
+        {
+            addRoad(junctions.at(path.startJunctionId), junctions.at(path.endJunctionId),
+                path.length, path.roadCondition, path.speedLimit, path.laneCount, nullptr);
+            continue;
+        }
+        addPavement(junctions.at(path.startJunctionId), junctions.at(path.endJunctionId),
+            path.length, nullptr);
+    }
+    fastestRoutes_ = network.routes;
 }
 
-Simulation::~Simulation() = default;
+Simulation::~Simulation()
+{
+    /* painters may be already deleted, so last frame is not painted */
+    if(isRunning())
+    {
+        engineRunning_ = false;
+        engine_.join();
+    }
+}
 
 void Simulation::setBasePrinters(interface::PointPainter* const junctionPainter,
     interface::LinePainter* const roadPainter,
@@ -56,30 +229,35 @@ void Simulation::setBasePrinters(interface::PointPainter* const junctionPainter,
     basePrintersSet_ = true;
 }
 
+void Simulation::setDensityPainter(interface::DensityPainter* const densityPainter)
+{
+    densityPainter_ = densityPainter;
+}
+
 std::optional<std::string> Simulation::start(uint32_t timeout)
 {
     if(!basePrintersSet_)
     {
         return "Base printers not set - program stopped!";
     }
-    for(const auto& roadConnection : roadConnections_)
+    const auto result = validate();
+    if(result.has_value())
     {
-        if(std::size(roadConnection.second) == 0)
-        {
-            return "At least one junction does not have any road going out of it";
-        }
+        return result;
     }
-    for(const auto& pavementConnection : pavementConnections_)
+    if(!isRunning())
     {
-        if(std::size(pavementConnection.second) == 0)
+        calculateFastestRoutes();
+        engineRunning_ = true;
+        tickInterval_ = std::chrono::milliseconds{timeout};
+        engine_ = std::thread{&Simulation::runEngine, this, timeout};
+        if(simulationRefreshTimer_ == nullptr)
         {
-            return "At least one junction does not have any pavement going out of it";
+            simulationRefreshTimer_ = std::make_unique<QTimer>();
+            QObject::connect(simulationRefreshTimer_.get(), &QTimer::timeout,
+                [this](){ paintFrame(); });
         }
-    }
-    if(!simulationRefreshTimer_->isActive())
-    {
-        calculateFastestRoutes();
-        simulationRefreshTimer_->start(timeout);
+        simulationRefreshTimer_->start(std::min(timeout, REFRESHINTERVAL));
         return {};
     }
     return "Unknown error";
@@ -87,15 +265,184 @@ std::optional<std::string> Simulation::start(uint32_t timeout)
 
 void Simulation::stop()
 {
-    if(simulationRefreshTimer_->isActive())
+    if(!isRunning())
     {
-        simulationRefreshTimer_->stop();
+        return;
     }
+    engineRunning_ = false;
+    engine_.join();
+    simulationRefreshTimer_->stop();
+    paintFrame();
 }
 
 bool Simulation::isRunning()
 {
-    return simulationRefreshTimer_->isActive();
+    return engine_.joinable();
+}
+
+std::optional<std::string> Simulation::run(const uint64_t ticks)
+{
+    if(isRunning())
+    {
+        return "Simulation is already running";
+    }
+    const auto result = validate();
+    if(result.has_value())
+    {
+        return result;
+    }
+    calculateFastestRoutes();
+    for(auto tick = uint64_t{0}; tick < ticks; ++tick)
+    {
+        updateObjects();
+    }
+    return {};
+}
+
+std::optional<std::string> Simulation::startRecording(const std::string& filePath)
+{
+    auto recorder = std::make_unique<TrajectoryRecorder>();
+    const auto result = recorder->open(filePath, captureLayout());
+    if(result.has_value())
+    {
+        return result;
+    }
+    recorder_ = std::move(recorder);
+    return {};
+}
+
+void Simulation::stopRecording()
+{
+    if(recorder_ == nullptr)
+    {
+        return;
+    }
+    recorder_->close();
+    recorder_ = nullptr;
+}
+
+bool Simulation::isRecording() const
+{
+    return recorder_ != nullptr;
+}
+
+uint64_t Simulation::getSeed() const
+{
+    return seed_;
+}
+
+void Simulation::setVisibleArea(const common::Point topLeft, const common::Point bottomRight)
+{
+    /* seqlock, version is odd while corners are written so engine never applies half of them */
+    const auto version = visibleAreaVersion_.load(std::memory_order_relaxed);
+    visibleAreaVersion_.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    visibleTopLeft_.store(packPoint(topLeft), std::memory_order_relaxed);
+    visibleBottomRight_.store(packPoint(bottomRight), std::memory_order_relaxed);
+    visibleAreaVersion_.store(version + 2, std::memory_order_release);
+}
+
+void Simulation::setDestination(const uint32_t destinationId)
+{
+    if(isRunning())
+    {
+        pendingDestinationId_ = destinationId;
+        return;
+    }
+    applyDestination(destinationId);
+}
+
+void Simulation::setDriverDistribution(const DriverDistribution& driverDistribution)
+{
+    driverDistribution_ = driverDistribution;
+}
+
+void Simulation::setSignalController(
+    const std::shared_ptr<const SignalController> signalController)
+{
+    signalController_ = signalController;
+    for(const auto& junction : junctions_)
+    {
+        junction->setSignalController(signalController_);
+    }
+}
+
+std::optional<std::string> Simulation::setDemand(const Demand& demand)
+{
+    const auto result = validateDemand(demand);
+    if(result.has_value())
+    {
+        return result;
+    }
+    demand_ = demand;
+    waitingDrivers_.assign(std::size(demand_.driverFlows), 0);
+    return {};
+}
+
+std::optional<std::string> Simulation::coordinateCorridor(
+    const std::vector<uint32_t>& junctionIds)
+{
+    if(std::size(junctionIds) < 2)
+    {
+        return "Corridor has to have at least two junctions";
+    }
+    auto corridorJunctions = std::vector<std::shared_ptr<Junction>>{};
+    auto corridorRoads = std::vector<std::shared_ptr<Road>>{};
+    for(auto iterator = std::size_t{1}; iterator < std::size(junctionIds); ++iterator)
+    {
+        const auto roads = roadConnections_.find(junctionIds[iterator - 1]);
+        if(roads == std::cend(roadConnections_))
+        {
+            return "Junctions of corridor are not connected by roads";
+        }
+        const auto road = std::find_if(roads->second.cbegin(), roads->second.cend(),
+            [&junctionIds, iterator](const std::shared_ptr<Road>& road)
+            { return road->getJunction()->getId() == junctionIds[iterator]; });
+        if(road == std::cend(roads->second))
+        {
+            return "Junctions of corridor are not connected by roads";
+        }
+        corridorJunctions.push_back((*road)->getJunction());
+        corridorRoads.push_back(*road);
+    }
+
+    /* cycle has to be divisible by length of round of lights of each junction */
+    auto cycleTicks = uint32_t{0};
+    auto roundsLcm = uint32_t{1};
+    for(const auto& junction : corridorJunctions)
+    {
+        cycleTicks = std::max(cycleTicks, junction->getCycleTicks());
+        roundsLcm = std::lcm(roundsLcm, std::max(junction->getIncomingRoadCount(),
+            uint32_t{1}));
+    }
+    const auto cycleStep = 2 * roundsLcm;
+    cycleTicks = (cycleTicks + cycleStep - 1) / cycleStep * cycleStep;
+
+    auto greenStartTick = tick_;
+    for(auto iterator = std::size_t{0}; iterator < std::size(corridorRoads); ++iterator)
+    {
+        const auto& road = corridorRoads[iterator];
+        if(iterator != 0)
+        {
+            const auto& previousRoad = corridorRoads[iterator - 1];
+            const auto& junction = corridorJunctions[iterator - 1];
+            const auto junctionRoad = junction->getJunctionRoad(previousRoad->getPathId(),
+                road->getPathId());
+            greenStartTick += junctionRoad->getLength() / junctionRoad->getSpeedLimit()
+                + road->getLength() / road->getSpeedLimit();
+        }
+        corridorJunctions[iterator]->coordinateLights(cycleTicks, road->getPathId(),
+            greenStartTick, tick_);
+    }
+
+    lightTimers_ = TimerWheel{tick_};
+    for(auto iterator = std::size_t{0}; iterator < std::size(junctions_); ++iterator)
+    {
+        lightTimers_.schedule(junctions_[iterator]->getLightChangeTick(),
+            static_cast<uint32_t>(iterator));
+    }
+    wakeDrivers(true);
+    return {};
 }
 
 const std::vector<std::shared_ptr<Junction>> &Simulation::getJunctions() const
@@ -103,9 +450,14 @@ const std::vector<std::shared_ptr<Junction>> &Simulation::getJunctions() const
     return junctions_;
 }
 
-const std::vector<std::shared_ptr<Driver> > &Simulation::getDrivers() const
+std::vector<std::shared_ptr<Driver>> Simulation::getDrivers() const
 {
-    return drivers_;
+    auto drivers = drivers_;
+    for(const auto& road : sleepingDrivers_)
+    {
+        drivers.insert(drivers.end(), road.second.cbegin(), road.second.cend());
+    }
+    return drivers;
 }
 
 const std::vector<std::shared_ptr<Pedestrian> > &Simulation::getPedestrians() const
@@ -145,20 +497,383 @@ std::map<uint32_t, std::vector<uint32_t>> Simulation::getConnectedJunctionsByPav
     return connectedJunctions;
 }
 
+std::map<uint32_t, RoadStatistics> Simulation::getRoadStatistics() const
+{
+    auto roadStatistics = std::map<uint32_t, RoadStatistics>{};
+    for(const auto& roads : roadConnections_)
+    {
+        for(const auto& road : roads.second)
+        {
+            roadStatistics[road->getPathId()] = road->getStatistics();
+        }
+    }
+    return roadStatistics;
+}
+
+std::optional<std::string> Simulation::createNetwork(Network& network)
+{
+    const auto result = validate();
+    if(result.has_value())
+    {
+        return result;
+    }
+    calculateFastestRoutes();
+
+    network.junctions.clear();
+    for(const auto& junction : junctions_)
+    {
+        network.junctions.push_back(junction->getPosition());
+    }
+    network.paths = capturePaths();
+    network.routes = fastestRoutes_;
+    return {};
+}
+
+common::Layout Simulation::captureLayout() const
+{
+    auto layout = common::Layout{};
+    for(const auto& junction : junctions_)
+    {
+        layout.junctions.push_back(junction->getPosition());
+    }
+    layout.roads.push_back({spawnRoad_->getStartPoint(), spawnRoad_->getEndPoint()});
+    for(const auto& roads : roadConnections_)
+    {
+        for(const auto& road : roads.second)
+        {
+            layout.roads.push_back({road->getStartPoint(), road->getEndPoint()});
+        }
+    }
+    layout.pavements.push_back({spawnPavement_->getStartPoint(), spawnPavement_->getEndPoint()});
+    for(const auto& pavements : pavementConnections_)
+    {
+        for(const auto& pavement : pavements.second)
+        {
+            layout.pavements.push_back({pavement->getStartPoint(), pavement->getEndPoint()});
+        }
+    }
+    return layout;
+}
+
+common::Frame Simulation::captureFrame() const
+{
+    auto frame = common::Frame{};
+    fillFrame(frame);
+    return frame;
+}
+
+void Simulation::fillFrame(common::Frame& frame) const
+{
+    frame.tick = tick_;
+    frame.drivers.clear();
+    frame.drivers.reserve(std::size(drivers_));
+    frame.driverIds.clear();
+    frame.driverIds.reserve(std::size(drivers_));
+    for(const auto& driver : drivers_)
+    {
+        frame.drivers.push_back(driver->getPosition());
+        frame.driverIds.push_back(driver->getId());
+    }
+    for(const auto& road : sleepingDrivers_)
+    {
+        for(const auto& driver : road.second)
+        {
+            frame.drivers.push_back(driver->getPosition());
+            frame.driverIds.push_back(driver->getId());
+        }
+    }
+    frame.pedestrians.clear();
+    frame.pedestrians.reserve(std::size(pedestrians_));
+    frame.pedestrianIds.clear();
+    frame.pedestrianIds.reserve(std::size(pedestrians_));
+    for(const auto& pedestrian : pedestrians_)
+    {
+        frame.pedestrians.push_back(pedestrian->getPosition());
+        frame.pedestrianIds.push_back(pedestrian->getId());
+    }
+    frame.roads.clear();
+    if(densityPainter_ == nullptr)
+    {
+        return;
+    }
+    frame.roads.push_back({{spawnRoad_->getStartPoint(), spawnRoad_->getEndPoint()},
+        spawnRoad_->getOccupancy()});
+    for(const auto& roads : roadConnections_)
+    {
+        for(const auto& road : roads.second)
+        {
+            frame.roads.push_back({{road->getStartPoint(), road->getEndPoint()},
+                road->getOccupancy()});
+        }
+    }
+}
+
+Checkpoint Simulation::createCheckpoint() const
+{
+    auto checkpoint = Checkpoint{};
+    checkpoint.seed = seed_;
+    checkpoint.randomCounter = random_.getCounter();
+    checkpoint.tick = tick_;
+
+    for(const auto& junction : junctions_)
+    {
+        checkpoint.junctions.push_back(junction->getState());
+    }
+    checkpoint.paths = capturePaths();
+
+    auto junctionRoads = std::map<const Road*, std::pair<uint32_t /* oldRoadId */,
+        uint32_t /* newRoadId */>>{};
+    for(const auto& junction : junctions_)
+    {
+        for(const auto& oldRoad : junction->getJunctionRoads())
+        {
+            for(const auto& newRoad : oldRoad.second)
+            {
+                junctionRoads[newRoad.second.get()] = std::make_pair(oldRoad.first, newRoad.first);
+            }
+        }
+    }
+    const auto drivers = getDrivers();
+    auto vehicleIndexes = std::map<const Vehicle*, int32_t>{{nullptr, NO_VEHICLE}};
+    for(auto iterator = std::size_t{0}; iterator < std::size(drivers); ++iterator)
+    {
+        vehicleIndexes[drivers[iterator]->getVehicle()] = static_cast<int32_t>(iterator);
+    }
+
+    for(const auto& driver : drivers)
+    {
+        auto state = driver->getState();
+        const auto road = driver->getRoad();
+        const auto vehicle = driver->getVehicle();
+
+        const auto junctionRoad = junctionRoads.find(road.get());
+        if(junctionRoad != std::cend(junctionRoads))
+        {
+            state.previousRoadId = junctionRoad->second.first;
+            state.roadId = junctionRoad->second.second;
+        }
+        state.vehicleAhead = vehicleIndexes.at(vehicle->getVehicleAhead());
+        state.vehicleBehind = vehicleIndexes.at(vehicle->getVehicleBehind());
+        state.isLastOnRoad = road->getLastVehicle(vehicle->getLane()) == vehicle;
+        checkpoint.drivers.push_back(state);
+    }
+    for(const auto& pedestrian : pedestrians_)
+    {
+        auto state = pedestrian->getState();
+        const auto pavement = pedestrian->getPavement();
+
+        if(pavement->getPathId() == DUMMY_ID)
+        {
+            state.onTemporaryPavement = true;
+            state.temporaryStartPoint = pavement->getStartPoint();
+            state.pavementId = pavement->getJunction()->getOutgoingPavements().front()
+                .lock()->getPathId();
+        }
+        checkpoint.pedestrians.push_back(state);
+    }
+    checkpoint.demand = demand_;
+    checkpoint.waitingDrivers = waitingDrivers_;
+    return checkpoint;
+}
+
+std::optional<std::string> Simulation::restoreCheckpoint(const Checkpoint& checkpoint)
+{
+    if(checkpoint.seed != seed_)
+    {
+        return "Checkpoint was created with different seed than simulation";
+    }
+    auto drivers = getDrivers();
+    if(std::size(checkpoint.junctions) != std::size(junctions_)
+        || std::size(checkpoint.drivers) != std::size(drivers)
+        || std::size(checkpoint.pedestrians) != std::size(pedestrians_))
+    {
+        return "Checkpoint does not match simulation";
+    }
+    for(auto iterator = std::size_t{0}; iterator < std::size(junctions_); ++iterator)
+    {
+        if(junctions_[iterator]->getId() != checkpoint.junctions[iterator].junctionId)
+        {
+            return "Checkpoint does not match simulation";
+        }
+    }
+
+    auto roads = std::map<uint32_t, std::shared_ptr<Road>>{{spawnRoad_->getPathId(), spawnRoad_}};
+    for(const auto& connections : roadConnections_)
+    {
+        for(const auto& road : connections.second)
+        {
+            roads[road->getPathId()] = road;
+        }
+    }
+    auto pavements = std::map<uint32_t, std::pair<std::shared_ptr<Junction> /* startJunction */,
+        std::shared_ptr<Path>>>{{spawnPavement_->getPathId(),
+        std::make_pair(junctions_.front(), spawnPavement_)}};
+    for(const auto& junction : junctions_)
+    {
+        for(const auto& pavement : pavementConnections_[junction->getId()])
+        {
+            pavements[pavement->getPathId()] = std::make_pair(junction, pavement);
+        }
+    }
+
+    const auto findRoad = [&roads](const DriverState& state)
+        {
+            if(state.previousRoadId != NO_ROAD)
+            {
+                return roads.at(state.previousRoadId)->getJunction()->getJunctionRoad(
+                    state.previousRoadId, state.roadId);
+            }
+            return roads.at(state.roadId);
+        };
+    for(const auto& state : checkpoint.drivers)
+    {
+        if(roads.find(state.roadId) == std::cend(roads)
+            || (state.previousRoadId != NO_ROAD && roads.find(state.previousRoadId) == std::cend(roads))
+            || state.vehicleAhead < NO_VEHICLE
+            || state.vehicleAhead >= static_cast<int32_t>(std::size(drivers))
+            || state.vehicleBehind < NO_VEHICLE
+            || state.vehicleBehind >= static_cast<int32_t>(std::size(drivers))
+            || state.lane >= findRoad(state)->getLaneCount())
+        {
+            return "Checkpoint does not match simulation";
+        }
+    }
+    for(const auto& state : checkpoint.pedestrians)
+    {
+        if(pavements.find(state.pavementId) == std::cend(pavements))
+        {
+            return "Checkpoint does not match simulation";
+        }
+    }
+    if(validateDemand(checkpoint.demand).has_value()
+        || std::size(checkpoint.waitingDrivers) != std::size(checkpoint.demand.driverFlows))
+    {
+        return "Checkpoint does not match simulation";
+    }
+
+    /* objects take ids from checkpoint, painters follow them */
+    auto driverPainters = std::unordered_map<uint32_t, PaintedObject>{};
+    for(auto iterator = std::size_t{0}; iterator < std::size(drivers); ++iterator)
+    {
+        const auto painter = driverPainters_.find(drivers[iterator]->getId());
+        if(painter != std::cend(driverPainters_))
+        {
+            driverPainters[checkpoint.drivers[iterator].objectId] = PaintedObject{
+                painter->second.painter, checkpoint.tick, common::HIDDENPOINT,
+                common::HIDDENPOINT};
+        }
+    }
+    driverPainters_ = std::move(driverPainters);
+    auto pedestrianPainters = std::unordered_map<uint32_t, PaintedObject>{};
+    for(auto iterator = std::size_t{0}; iterator < std::size(pedestrians_); ++iterator)
+    {
+        const auto painter = pedestrianPainters_.find(pedestrians_[iterator]->getId());
+        if(painter != std::cend(pedestrianPainters_))
+        {
+            pedestrianPainters[checkpoint.pedestrians[iterator].objectId] = PaintedObject{
+                painter->second.painter, checkpoint.tick, common::HIDDENPOINT,
+                common::HIDDENPOINT};
+        }
+    }
+    pedestrianPainters_ = std::move(pedestrianPainters);
+
+    tick_ = checkpoint.tick;
+    random_.setCounter(checkpoint.randomCounter);
+    lightTimers_ = TimerWheel{tick_};
+    for(auto iterator = std::size_t{0}; iterator < std::size(junctions_); ++iterator)
+    {
+        junctions_[iterator]->restoreState(checkpoint.junctions[iterator]);
+        lightTimers_.schedule(junctions_[iterator]->getLightChangeTick(),
+            static_cast<uint32_t>(iterator));
+        for(const auto& oldRoad : junctions_[iterator]->getJunctionRoads())
+        {
+            for(const auto& newRoad : oldRoad.second)
+            {
+                newRoad.second->clearVehicles();
+            }
+        }
+    }
+    for(const auto& road : roads)
+    {
+        road.second->clearVehicles();
+    }
+
+    for(auto iterator = std::size_t{0}; iterator < std::size(drivers); ++iterator)
+    {
+        const auto& state = checkpoint.drivers[iterator];
+        drivers[iterator]->restoreState(state, findRoad(state));
+        movingObjectId_ = std::max(movingObjectId_, state.objectId);
+    }
+    for(auto iterator = std::size_t{0}; iterator < std::size(drivers); ++iterator)
+    {
+        const auto& state = checkpoint.drivers[iterator];
+        if(!state.isLastOnRoad)
+        {
+            continue;
+        }
+        auto vehicles = std::vector<Vehicle*>{};
+        for(auto vehicle = static_cast<int32_t>(iterator); vehicle != NO_VEHICLE
+            && std::size(vehicles) < std::size(drivers);
+            vehicle = checkpoint.drivers[vehicle].vehicleAhead)
+        {
+            vehicles.push_back(drivers[vehicle]->getVehicle());
+        }
+        std::reverse(vehicles.begin(), vehicles.end());
+        drivers[iterator]->getRoad()->restoreLane(state.lane, vehicles);
+    }
+
+    drivers_.clear();
+    sleepingDrivers_.clear();
+    for(auto iterator = std::size_t{0}; iterator < std::size(drivers); ++iterator)
+    {
+        if(!checkpoint.drivers[iterator].asleep)
+        {
+            drivers_.push_back(drivers[iterator]);
+            continue;
+        }
+        drivers[iterator]->sleep(checkpoint.drivers[iterator].asleepSinceTick);
+        sleepingDrivers_[drivers[iterator]->getRoad()->getPathId()].push_back(drivers[iterator]);
+    }
+
+    for(auto iterator = std::size_t{0}; iterator < std::size(pedestrians_); ++iterator)
+    {
+        const auto& state = checkpoint.pedestrians[iterator];
+        const auto& pavement = pavements.at(state.pavementId);
+        if(state.onTemporaryPavement)
+        {
+            pedestrians_[iterator]->restoreState(state, pavement.first->createTemporaryPavement(
+                state.temporaryStartPoint, pavement.second));
+            continue;
+        }
+        pedestrians_[iterator]->restoreState(state, pavement.second);
+    }
+    for(const auto& state : checkpoint.pedestrians)
+    {
+        movingObjectId_ = std::max(movingObjectId_, state.objectId);
+    }
+    demand_ = checkpoint.demand;
+    waitingDrivers_ = checkpoint.waitingDrivers;
+    return {};
+}
+
 void Simulation::addJunction(const common::Point position,
     interface::PointPainter* const painter)
 {
     junctionId_++;
-    auto junction = std::make_shared<Junction>(junctionId_, position);
+    auto junction = std::make_shared<Junction>(junctionId_, position, seed_, tick_);
     junction->setPainter(painter);
+    junction->setSignalController(signalController_);
+    lightTimers_.schedule(junction->getLightChangeTick(),
+        static_cast<uint32_t>(std::size(junctions_)));
     junctions_.push_back(junction);
     roadConnections_[junctionId_] = {};
     pavementConnections_[junctionId_] = {};
+    fastestRoutes_.clear();
 }
 
 void Simulation::addRoad(const std::shared_ptr<Junction> startJunction,
     const std::shared_ptr<Junction> endJunction, const uint32_t length,
-    const RoadCondition roadCondition, const uint32_t speedLimit,
+    const RoadCondition roadCondition, const uint32_t speedLimit, const uint32_t laneCount,
     interface::LinePainter* const painter)
 {
     pathId_++;
@@ -167,12 +882,13 @@ void Simulation::addRoad(const std::shared_ptr<Junction> startJunction,
     calculatePathPoints(startPoint, endPoint, ROADOFFSET, length);
 
     auto road = std::make_shared<Road>(pathId_, length, startPoint, endPoint,
-        endJunction, roadCondition, speedLimit);
+        endJunction, roadCondition, speedLimit, laneCount);
     road->setPainter(painter);
     road->update();
     startJunction->addOutgoingRoad(road);
     endJunction->addIncomingRoad(road);
     roadConnections_[startJunction->getId()].push_back(road);
+    fastestRoutes_.clear();
 }
 
 void Simulation::addPavement(const std::shared_ptr<Junction> startJunction,
@@ -189,21 +905,22 @@ void Simulation::addPavement(const std::shared_ptr<Junction> startJunction,
     pavement->update();
     startJunction->addOutgoingPavement(pavement);
     pavementConnections_[startJunction->getId()].push_back(pavement);
+    fastestRoutes_.clear();
 }
 
 void Simulation::addDriver(interface::PointPainter* const painter)
 {
-    auto vehicle = generateRandomVehicle();
+    auto vehicle = generateRandomVehicle(driverDistribution_);
     spawnRoad_->addVehicle(vehicle.get());
-    addDriver(generateRandomDriver(std::move(vehicle)), std::move(painter));
+    addDriver(generateRandomDriver(spawnRoad_, std::move(vehicle), driverDistribution_), std::move(painter));
 }
 
 void Simulation::addDriver(const uint32_t maxAcceleration, const uint32_t maxDeceleration,
     interface::PointPainter* const painter)
 {
-    auto vehicle = std::make_unique<Vehicle>(maxAcceleration, maxDeceleration);
+    auto vehicle = createVehicle(maxAcceleration, maxDeceleration);
     spawnRoad_->addVehicle(vehicle.get());
-    addDriver(generateRandomDriver(std::move(vehicle)),
+    addDriver(generateRandomDriver(spawnRoad_, std::move(vehicle), driverDistribution_),
         std::move(painter));
 }
 
@@ -211,11 +928,11 @@ void Simulation::addDriver(const float accelerationRate,
     const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
     const float roadConditionSpeedModifier, interface::PointPainter* const painter)
 {
-    auto vehicle = generateRandomVehicle();
+    auto vehicle = generateRandomVehicle(driverDistribution_);
     spawnRoad_->addVehicle(vehicle.get());
-    addDriver(std::make_shared<Driver>(spawnRoad_, std::move(vehicle), accelerationRate,
-        minDistanceToVehicleAhead, maxSpeedOverLimit, roadConditionSpeedModifier),
-        std::move(painter));
+    addDriver(createDriver(spawnRoad_, std::move(vehicle),
+        accelerationRate, minDistanceToVehicleAhead, maxSpeedOverLimit,
+        roadConditionSpeedModifier), std::move(painter));
 }
 
 void Simulation::addDriver(const uint32_t maxAcceleration, const uint32_t maxDeceleration,
@@ -223,58 +940,409 @@ void Simulation::addDriver(const uint32_t maxAcceleration, const uint32_t maxDec
     const uint32_t maxSpeedOverLimit, const float roadConditionSpeedModifier,
     interface::PointPainter* const painter)
 {
-    auto vehicle = std::make_unique<Vehicle>(maxAcceleration, maxDeceleration);
+    auto vehicle = createVehicle(maxAcceleration, maxDeceleration);
     spawnRoad_->addVehicle(vehicle.get());
-    addDriver(std::make_shared<Driver>(spawnRoad_, std::move(vehicle), accelerationRate,
-        minDistanceToVehicleAhead, maxSpeedOverLimit, roadConditionSpeedModifier),
-        std::move(painter));
+    addDriver(createDriver(spawnRoad_, std::move(vehicle),
+        accelerationRate, minDistanceToVehicleAhead, maxSpeedOverLimit,
+        roadConditionSpeedModifier), std::move(painter));
 }
 
 void Simulation::addPedestrian(interface::PointPainter* const painter)
 {
-    auto maxSpeed = static_cast<uint32_t>(std::rand() % 81 + 40); /* 40 - 120 */
-    addPedestrian(std::make_shared<Pedestrian>(spawnPavement_, maxSpeed), std::move(painter));
+    auto maxSpeed = random_.nextInRange(DEFAULTPEDESTRIANMAXSPEED.min,
+        DEFAULTPEDESTRIANMAXSPEED.max);
+    addPedestrian(maxSpeed, std::move(painter));
 }
 
 void Simulation::addPedestrian(const uint32_t maxSpeed, interface::PointPainter* const painter)
 {
-    addPedestrian(std::make_shared<Pedestrian>(spawnPavement_, maxSpeed), std::move(painter));
+    addPedestrian(createPedestrian(spawnPavement_, maxSpeed), std::move(painter));
 }
 
-void Simulation::updateObjects()
+void Simulation::addDrivers(const uint32_t count, const DriverDistribution& distribution)
 {
-    for(const auto& junction : junctions_)
+    drivers_.reserve(std::size(drivers_) + count);
+    auto vehicles = std::vector<Vehicle*>{};
+    vehicles.reserve(count);
+
+    for(auto iterator = uint32_t{0}; iterator < count; ++iterator)
     {
-        junction->update();
+        auto vehicle = generateRandomVehicle(distribution);
+        vehicles.push_back(vehicle.get());
+        drivers_.push_back(generateRandomDriver(spawnRoad_, std::move(vehicle), distribution));
     }
+    spawnRoad_->addVehicles(vehicles);
+}
+
+void Simulation::addPedestrians(const uint32_t count, const Range<uint32_t> maxSpeed)
+{
+    pedestrians_.reserve(std::size(pedestrians_) + count);
+
+    for(auto iterator = uint32_t{0}; iterator < count; ++iterator)
+    {
+        const auto pedestrianMaxSpeed = random_.nextInRange(maxSpeed.min, maxSpeed.max);
+        pedestrians_.push_back(createPedestrian(spawnPavement_, pedestrianMaxSpeed));
+    }
+}
+
+void Simulation::runEngine(const uint32_t timeout)
+{
+    auto nextTickTime = std::chrono::steady_clock::now();
+    while(engineRunning_)
+    {
+        const auto destinationId = pendingDestinationId_.exchange(NO_DESTINATION);
+        if(destinationId != NO_DESTINATION)
+        {
+            applyDestination(destinationId);
+        }
+        updateObjects();
+        fillFrame(frames_.getBack());
+        frames_.publish();
+
+        nextTickTime += std::chrono::milliseconds{timeout};
+        std::this_thread::sleep_until(nextTickTime);
+    }
+}
+
+void Simulation::paintFrame()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto newFrame = frames_.consume();
+    if(newFrame)
+    {
+        currentFrame_ = frames_.getFront();
+        currentFrameTime_ = now;
+        takePositions(driverPainters_, currentFrame_.tick, currentFrame_.drivers,
+            currentFrame_.driverIds);
+        takePositions(pedestrianPainters_, currentFrame_.tick, currentFrame_.pedestrians,
+            currentFrame_.pedestrianIds);
+    }
+
+    auto progress = float{1};
+    if(isRunning() && tickInterval_.count() > 0)
+    {
+        progress = std::min(float{1}, std::chrono::duration<float>(now - currentFrameTime_)
+            / std::chrono::duration<float>(tickInterval_));
+    }
+    paintAgents(driverPainters_, progress);
+    paintAgents(pedestrianPainters_, progress);
+
+    if(newFrame && densityPainter_ != nullptr)
+    {
+        densityPainter_->setRoadLoads(currentFrame_.roads);
+        densityPainter_->paint();
+    }
+}
+
+void Simulation::updateVisiblePaths()
+{
+    auto visibleTopLeft = WORLDTOPLEFT;
+    auto visibleBottomRight = WORLDBOTTOMRIGHT;
+    if(recorder_ == nullptr)
+    {
+        auto version = uint32_t{0};
+        do
+        {
+            version = visibleAreaVersion_.load(std::memory_order_acquire);
+            visibleTopLeft = visibleTopLeft_.load(std::memory_order_relaxed);
+            visibleBottomRight = visibleBottomRight_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        while(version % 2 != 0 || visibleAreaVersion_.load(std::memory_order_relaxed) != version);
+    }
+    if(visibleTopLeft == appliedTopLeft_ && visibleBottomRight == appliedBottomRight_)
+    {
+        return;
+    }
+    appliedTopLeft_ = visibleTopLeft;
+    appliedBottomRight_ = visibleBottomRight;
+    const auto topLeft = unpackPoint(visibleTopLeft);
+    const auto bottomRight = unpackPoint(visibleBottomRight);
+
+    spawnRoad_->setVisible(isInArea(*spawnRoad_, topLeft, bottomRight));
+    spawnPavement_->setVisible(isInArea(*spawnPavement_, topLeft, bottomRight));
     for(const auto& roads : roadConnections_)
     {
         for(const auto& road : roads.second)
         {
-            road->update();
+            road->setVisible(isInArea(*road, topLeft, bottomRight));
         }
     }
     for(const auto& pavements : pavementConnections_)
     {
         for(const auto& pavement : pavements.second)
         {
-            pavement->update();
+            pavement->setVisible(isInArea(*pavement, topLeft, bottomRight));
         }
     }
-    for(const auto& driver : drivers_)
+    for(const auto& junction : junctions_)
     {
-        driver->update();
+        for(const auto& junctionRoads : junction->getJunctionRoads())
+        {
+            for(const auto& junctionRoad : junctionRoads.second)
+            {
+                junctionRoad.second->setVisible(isInArea(*junctionRoad.second, topLeft,
+                    bottomRight));
+            }
+        }
+    }
+    for(const auto& road : sleepingDrivers_)
+    {
+        for(const auto& driver : road.second)
+        {
+            driver->updatePosition();
+        }
+    }
+}
+
+void Simulation::applyDestination(const uint32_t destinationId)
+{
+    for(const auto& driver : getDrivers())
+    {
+        driver->setDestination(destinationId);
     }
     for(const auto& pedestrian : pedestrians_)
     {
-        pedestrian->update();
+        pedestrian->setDestination(destinationId);
+    }
+}
+
+void Simulation::updateObjects()
+{
+    updateVisiblePaths();
+    spawnDemand();
+
+    const auto changedJunctions = lightTimers_.advance();
+    for(const auto junctionIndex : changedJunctions)
+    {
+        const auto& junction = junctions_[junctionIndex];
+        junction->update();
+        lightTimers_.schedule(junction->getLightChangeTick(), junctionIndex);
+    }
+    wakeDrivers(!changedJunctions.empty());
+    for(auto iterator = std::size_t{0}; iterator < std::size(drivers_);)
+    {
+        drivers_[iterator]->update();
+        if(drivers_[iterator]->hasArrived())
+        {
+            releaseDriver(iterator);
+            continue;
+        }
+        if(drivers_[iterator]->canSleep())
+        {
+            sleepDriver(iterator);
+            continue;
+        }
+        ++iterator;
+    }
+    for(auto iterator = std::size_t{0}; iterator < std::size(pedestrians_);)
+    {
+        pedestrians_[iterator]->update();
+        if(pedestrians_[iterator]->hasArrived())
+        {
+            releasePedestrian(iterator);
+            continue;
+        }
+        ++iterator;
+    }
+    tick_++;
+
+    if(recorder_ != nullptr)
+    {
+        recorder_->record(captureFrame());
+    }
+}
+
+std::optional<std::string> Simulation::validateDemand(const Demand& demand) const
+{
+    for(const auto& flows : {demand.driverFlows, demand.pedestrianFlows})
+    {
+        for(const auto& flow : flows)
+        {
+            if(findJunction(flow.originId) == nullptr
+                || findJunction(flow.destinationId) == nullptr
+                || flow.originId == flow.destinationId)
+            {
+                return "Flow of demand does not connect two different junctions";
+            }
+        }
+    }
+    return {};
+}
+
+std::shared_ptr<Junction> Simulation::findJunction(const uint32_t junctionId) const
+{
+    /* junctions are added with increasing ids */
+    const auto junction = std::lower_bound(junctions_.cbegin(), junctions_.cend(), junctionId,
+        [](const std::shared_ptr<Junction>& junction, const uint32_t junctionId)
+        { return junction->getId() < junctionId; });
+    if(junction == junctions_.cend() || (*junction)->getId() != junctionId)
+    {
+        return nullptr;
+    }
+    return *junction;
+}
+
+void Simulation::spawnDemand()
+{
+    for(auto iterator = std::size_t{0}; iterator < std::size(demand_.driverFlows); ++iterator)
+    {
+        const auto& flow = demand_.driverFlows[iterator];
+        auto& waitingDrivers = waitingDrivers_[iterator];
+        waitingDrivers += drawArrivals(flow);
+        if(waitingDrivers == 0)
+        {
+            continue;
+        }
+
+        const auto road = findJunction(flow.originId)->getFastestRoad(flow.destinationId);
+        if(road == nullptr)
+        {
+            // destination cannot be reached from origin, drivers would never arrive
+            waitingDrivers = 0;
+            continue;
+        }
+        const auto lastVehicle = road->getLastVehicle(road->getEntryLane());
+        if(lastVehicle != nullptr && lastVehicle->getDistanceTravelled() < SOURCEGAP)
+        {
+            continue;
+        }
+        auto vehicle = generateRandomVehicle(demand_.driverDistribution);
+        road->addVehicle(vehicle.get());
+        auto driver = generateRandomDriver(road, std::move(vehicle),
+            demand_.driverDistribution);
+        driver->setDestination(flow.destinationId, true);
+        drivers_.push_back(driver);
+        waitingDrivers--;
+    }
+
+    for(const auto& flow : demand_.pedestrianFlows)
+    {
+        const auto pavement = findJunction(flow.originId)->getFastestPavement(
+            flow.destinationId);
+        auto arrivals = drawArrivals(flow);
+        if(pavement == nullptr)
+        {
+            continue;
+        }
+        for(; arrivals > 0; --arrivals)
+        {
+            const auto maxSpeed = random_.nextInRange(demand_.pedestrianMaxSpeed.min,
+                demand_.pedestrianMaxSpeed.max);
+            auto pedestrian = createPedestrian(pavement, maxSpeed);
+            pedestrian->setDestination(flow.destinationId, true);
+            pedestrians_.push_back(pedestrian);
+        }
+    }
+}
+
+uint32_t Simulation::drawArrivals(const DemandFlow& flow)
+{
+    const auto rate = std::upper_bound(flow.rates.cbegin(), flow.rates.cend(), tick_,
+        [](const uint64_t tick, const DemandRate& rate){ return tick < rate.startTick; });
+    if(rate == flow.rates.cbegin())
+    {
+        return 0;
+    }
+    const auto agentsPerTick = std::prev(rate)->agentsPerTick;
+    const auto arrivals = static_cast<uint32_t>(agentsPerTick);
+    return arrivals + (random_.nextFloat() < agentsPerTick - arrivals ? 1 : 0);
+}
+
+void Simulation::wakeDrivers(const bool lightsChanged)
+{
+    for(auto road = sleepingDrivers_.begin(); road != sleepingDrivers_.end();)
+    {
+        const auto& path = road->second.front()->getRoad();
+        /* leader of queue left or changed lane, followers would wait for it forever */
+        const auto queueChanged = path->takeSleepingQueueChange();
+        if(!queueChanged && !(lightsChanged && path->hasGreenLight()))
+        {
+            ++road;
+            continue;
+        }
+        for(const auto& driver : road->second)
+        {
+            driver->wake(tick_);
+            drivers_.push_back(driver);
+        }
+        road = sleepingDrivers_.erase(road);
+    }
+}
+
+void Simulation::sleepDriver(const std::size_t index)
+{
+    auto driver = std::move(drivers_[index]);
+    if(index + 1 != std::size(drivers_))
+    {
+        drivers_[index] = std::move(drivers_.back());
+    }
+    drivers_.pop_back();
+
+    driver->sleep(tick_ + 1);
+    sleepingDrivers_[driver->getRoad()->getPathId()].push_back(std::move(driver));
+}
+
+void Simulation::releaseDriver(const std::size_t index)
+{
+    auto driver = std::move(drivers_[index]);
+    if(index + 1 != std::size(drivers_))
+    {
+        drivers_[index] = std::move(drivers_.back());
+    }
+    drivers_.pop_back();
+
+    if(driver.use_count() == 1)
+    {
+        freeVehicles_.push_back(driver->releaseVehicle());
+        freeDrivers_.push_back(std::move(driver));
     }
 }
 
+void Simulation::releasePedestrian(const std::size_t index)
+{
+    auto pedestrian = std::move(pedestrians_[index]);
+    if(index + 1 != std::size(pedestrians_))
+    {
+        pedestrians_[index] = std::move(pedestrians_.back());
+    }
+    pedestrians_.pop_back();
+
+    if(pedestrian.use_count() == 1)
+    {
+        freePedestrians_.push_back(std::move(pedestrian));
+    }
+}
+
+std::optional<std::string> Simulation::validate() const
+{
+    for(const auto& roadConnection : roadConnections_)
+    {
+        if(std::size(roadConnection.second) == 0)
+        {
+            return "At least one junction does not have any road going out of it";
+        }
+    }
+    for(const auto& pavementConnection : pavementConnections_)
+    {
+        if(std::size(pavementConnection.second) == 0)
+        {
+            return "At least one junction does not have any pavement going out of it";
+        }
+    }
+    return {};
+}
+
 void Simulation::calculateFastestRoutes()
 {
     for(const auto& junction : junctions_)
     {
+        if(fastestRoutes_.find(junction->getId()) != std::cend(fastestRoutes_))
+        {
+            junction->setFastestRoutes(fastestRoutes_.at(junction->getId()));
+            continue;
+        }
+        auto fastestRoutes = std::make_shared<Routes>();
         const auto& roadToJunctions = calculateConnections(junction, roadConnections_,
             [](const std::shared_ptr<Road> road){ return road->getLength() / road->getSpeedLimit(); });
         const auto& pavementToJunctions = calculateConnections<Path>(junction, pavementConnections_,
@@ -293,11 +1361,12 @@ void Simulation::calculateFastestRoutes()
             {
                 pavementRoute = pavementToJunctions.at(pavementRoute.first);
             }
-            junction->setFastestRoute(roadToJunction.first,
-                std::make_pair(roadRoute.second, pavementRoute.second));
+            (*fastestRoutes)[roadToJunction.first] = Route{roadRoute.second->getPathId(),
+                pavementRoute.second->getPathId()};
         }
+        fastestRoutes_[junction->getId()] = fastestRoutes;
+        junction->setFastestRoutes(fastestRoutes);
     }
-
 }
 
 template<class T, typename Functor>
@@ -369,8 +1438,7 @@ void Simulation::calculatePathPoints(common::Point &startPoint, common::Point &e
     }
 
     const auto junctionRadiusSquared = (JUNCTIONRADIUS - 2) * (JUNCTIONRADIUS - 2);
-    auto startPointShift = common::Point{static_cast<int16_t>(endPoint.x - startPoint.x),
-        static_cast<int16_t>(endPoint.y - startPoint.y)};
+    auto startPointShift = common::Point{endPoint.x - startPoint.x, endPoint.y - startPoint.y};
     auto currentLength = length;
     auto traversedLength = 0;
 
@@ -379,8 +1447,8 @@ void Simulation::calculatePathPoints(common::Point &startPoint, common::Point &e
     {
         currentLength /= 2;
 
-        auto changeOnX = endPoint.x - endJunctionPosition.x;
-        auto changeOnY = endPoint.y - endJunctionPosition.y;
+        auto changeOnX = int64_t{endPoint.x} - endJunctionPosition.x;
+        auto changeOnY = int64_t{endPoint.y} - endJunctionPosition.y;
         if((changeOnX * changeOnX) + (changeOnY * changeOnY) > junctionRadiusSquared)
         {
             traversedLength += currentLength;
@@ -394,8 +1462,7 @@ void Simulation::calculatePathPoints(common::Point &startPoint, common::Point &e
         endPoint.y = startPoint.y + (startPointShift.y * partTravelled);
     }
 
-    auto endPointShift = common::Point{static_cast<int16_t>(startPoint.x - endPoint.x),
-        static_cast<int16_t>(startPoint.y - endPoint.y)};
+    auto endPointShift = common::Point{startPoint.x - endPoint.x, startPoint.y - endPoint.y};
     currentLength = length;
     traversedLength = 0;
 
@@ -404,8 +1471,8 @@ void Simulation::calculatePathPoints(common::Point &startPoint, common::Point &e
     {
         currentLength /= 2;
 
-        auto changeOnX = startPoint.x - startJunctionPosition.x;
-        auto changeOnY = startPoint.y - startJunctionPosition.y;
+        auto changeOnX = int64_t{startPoint.x} - startJunctionPosition.x;
+        auto changeOnY = int64_t{startPoint.y} - startJunctionPosition.y;
         if((changeOnX * changeOnX) + (changeOnY * changeOnY) > junctionRadiusSquared)
         {
             traversedLength += currentLength;
@@ -423,7 +1490,10 @@ void Simulation::calculatePathPoints(common::Point &startPoint, common::Point &e
 void Simulation::generateBaseSimulation()
 {
     junctionId_++;
-    auto junction = std::make_shared<Junction>(junctionId_, BASEENDPOINT);
+    auto junction = std::make_shared<Junction>(junctionId_, BASEENDPOINT, seed_, tick_);
+    junction->setSignalController(signalController_);
+    lightTimers_.schedule(junction->getLightChangeTick(),
+        static_cast<uint32_t>(std::size(junctions_)));
     junctions_.push_back(junction);
     roadConnections_[junctionId_] = {};
     pavementConnections_[junctionId_] = {};
@@ -437,7 +1507,7 @@ void Simulation::generateBaseSimulation()
 
     pathId_++;
     spawnRoad_ = std::make_shared<Road>(pathId_, SPAWNPATHSLENGTH, startPointRoad,
-        endPointRoad, junction, RoadCondition::NoPotHoles, 700);
+        endPointRoad, junction, RoadCondition::NoPotHoles, 700, SPAWNROADLANECOUNT);
     junction->addIncomingRoad(spawnRoad_);
 
     pathId_++;
@@ -445,38 +1515,125 @@ void Simulation::generateBaseSimulation()
         endPointPavement, junction);
 }
 
-std::unique_ptr<Vehicle> Simulation::generateRandomVehicle() const
+std::vector<PathState> Simulation::capturePaths() const
 {
-    auto maxAcceleration = static_cast<uint32_t>(std::rand() % 4 + 5); /* 5 - 8 */
-    auto maxDeceleration = static_cast<uint32_t>(std::rand() % 15 + 10); /* 14 - 24 */
+    auto paths = std::vector<PathState>{};
+    for(const auto& roads : roadConnections_)
+    {
+        for(const auto& road : roads.second)
+        {
+            paths.push_back({road->getPathId(), PathType::Road, roads.first,
+                road->getJunction()->getId(), road->getLength(), road->getRoadCondition(),
+                road->getSpeedLimit(), road->getLaneCount()});
+        }
+    }
+    for(const auto& pavements : pavementConnections_)
+    {
+        for(const auto& pavement : pavements.second)
+        {
+            paths.push_back({pavement->getPathId(), PathType::Pavement,
+                pavements.first, pavement->getJunction()->getId(), pavement->getLength(),
+                RoadCondition::NoPotHoles, 0, 0});
+        }
+    }
+    std::sort(paths.begin(), paths.end(),
+        [](const PathState& lhs, const PathState& rhs){ return lhs.pathId < rhs.pathId; });
+    return paths;
+}
+
+std::unique_ptr<Vehicle> Simulation::generateRandomVehicle(
+    const DriverDistribution& distribution)
+{
+    auto maxAcceleration = random_.nextInRange(distribution.maxAcceleration.min,
+        distribution.maxAcceleration.max);
+    auto maxDeceleration = random_.nextInRange(distribution.maxDeceleration.min,
+        distribution.maxDeceleration.max);
 
-    return std::make_unique<Vehicle>(maxAcceleration, maxDeceleration);
+    return createVehicle(maxAcceleration, maxDeceleration);
 }
 
-std::shared_ptr<Driver> Simulation::generateRandomDriver(std::unique_ptr<Vehicle> vehicle) const
+std::shared_ptr<Driver> Simulation::generateRandomDriver(const std::shared_ptr<Road> road,
+    std::unique_ptr<Vehicle> vehicle, const DriverDistribution& distribution)
 {
-    const auto accelerationRate = static_cast<float>(std::rand()) / ( static_cast<float>(RAND_MAX/(0.8)))
-        + float{0.2}; /* 0.2 - 1 */
-    const auto minDistanceToVehicleAhead = static_cast<uint32_t>(std::rand() % 8001 + uint32_t{1000}); /* 1000 - 9000 */
-    const auto maxSpeedOverLimit = static_cast<uint32_t>(std::rand() % 301); /* 0 - 300 */
-    const auto roadConditionSpeedModifier = static_cast<float>(std::rand())
-        / ( static_cast<float>(RAND_MAX/(0.15))); /* 0 - 0.15 */
+    const auto accelerationRate = distribution.accelerationRate.min + random_.nextFloat()
+        * (distribution.accelerationRate.max - distribution.accelerationRate.min);
+    const auto minDistanceToVehicleAhead = random_.nextInRange(
+        distribution.minDistanceToVehicleAhead.min, distribution.minDistanceToVehicleAhead.max);
+    const auto maxSpeedOverLimit = random_.nextInRange(distribution.maxSpeedOverLimit.min,
+        distribution.maxSpeedOverLimit.max);
+    const auto roadConditionSpeedModifier = distribution.roadConditionSpeedModifier.min
+        + random_.nextFloat() * (distribution.roadConditionSpeedModifier.max
+        - distribution.roadConditionSpeedModifier.min);
+
+    return createDriver(road, std::move(vehicle), accelerationRate, minDistanceToVehicleAhead,
+        maxSpeedOverLimit, roadConditionSpeedModifier);
+}
 
-    return std::make_shared<Driver>(spawnRoad_, std::move(vehicle), accelerationRate,
+std::unique_ptr<Vehicle> Simulation::createVehicle(const uint32_t maxAcceleration,
+    const uint32_t maxDeceleration)
+{
+    if(freeVehicles_.empty())
+    {
+        return std::make_unique<Vehicle>(maxAcceleration, maxDeceleration);
+    }
+    auto vehicle = std::move(freeVehicles_.back());
+    freeVehicles_.pop_back();
+    vehicle->reset(maxAcceleration, maxDeceleration);
+    return vehicle;
+}
+
+std::shared_ptr<Driver> Simulation::createDriver(const std::shared_ptr<Road> road,
+    std::unique_ptr<Vehicle> vehicle, const float accelerationRate,
+    const uint32_t minDistanceToVehicleAhead, const uint32_t maxSpeedOverLimit,
+    const float roadConditionSpeedModifier)
+{
+    movingObjectId_++;
+    if(freeDrivers_.empty())
+    {
+        return std::make_shared<Driver>(movingObjectId_, seed_, road, std::move(vehicle),
+            accelerationRate, minDistanceToVehicleAhead, maxSpeedOverLimit,
+            roadConditionSpeedModifier);
+    }
+    auto driver = std::move(freeDrivers_.back());
+    freeDrivers_.pop_back();
+    driver->respawn(movingObjectId_, road, std::move(vehicle), accelerationRate,
         minDistanceToVehicleAhead, maxSpeedOverLimit, roadConditionSpeedModifier);
+    return driver;
+}
+
+std::shared_ptr<Pedestrian> Simulation::createPedestrian(const std::shared_ptr<Path> pavement,
+    const uint32_t maxSpeed)
+{
+    movingObjectId_++;
+    if(freePedestrians_.empty())
+    {
+        return std::make_shared<Pedestrian>(movingObjectId_, seed_, pavement, maxSpeed);
+    }
+    auto pedestrian = std::move(freePedestrians_.back());
+    freePedestrians_.pop_back();
+    pedestrian->respawn(movingObjectId_, pavement, maxSpeed);
+    return pedestrian;
 }
 
 void Simulation::addDriver(std::shared_ptr<Driver> driver,
     interface::PointPainter* const painter)
 {
-    driver->setPainter(painter);
+    if(painter != nullptr)
+    {
+        driverPainters_[driver->getId()] = PaintedObject{painter, tick_, common::HIDDENPOINT,
+            common::HIDDENPOINT};
+    }
     drivers_.push_back(driver);
 }
 
 void Simulation::addPedestrian(std::shared_ptr<Pedestrian> pedestrian,
     interface::PointPainter* const painter)
 {
-    pedestrian->setPainter(painter);
+    if(painter != nullptr)
+    {
+        pedestrianPainters_[pedestrian->getId()] = PaintedObject{painter, tick_,
+            common::HIDDENPOINT, common::HIDDENPOINT};
+    }
     pedestrians_.push_back(pedestrian);
 }
 
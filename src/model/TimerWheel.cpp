@@ -0,0 +1,71 @@
+#include "../include/model/TimerWheel.hpp"
+
+#include <algorithm>
+
+namespace trafficsimulation::model
+{
+
+TimerWheel::TimerWheel(const uint64_t tick)
+    : tick_{tick}
+    , slots_{}
+{
+}
+
+TimerWheel::~TimerWheel() = default;
+
+void TimerWheel::schedule(const uint64_t tick, const uint32_t timerId)
+{
+    const auto expiryTick = std::max(tick, tick_);
+    const auto delta = expiryTick - tick_;
+
+    auto level = std::size_t{0};
+    while(level + 1 < WHEELLEVELS && (delta >> (SLOTBITS * (level + 1))) != 0)
+    {
+        level++;
+    }
+    const auto slot = (expiryTick >> (SLOTBITS * level)) & (WHEELSLOTS - 1);
+    slots_[level][slot].push_back(Timer{expiryTick, timerId});
+}
+
+std::vector<uint32_t> TimerWheel::advance()
+{
+    /* higher levels go first, so timers moved by them are moved again by lower levels */
+    auto highestLevel = std::size_t{0};
+    while(highestLevel + 1 < WHEELLEVELS
+        && (tick_ & ((uint64_t{1} << (SLOTBITS * (highestLevel + 1))) - 1)) == 0)
+    {
+        highestLevel++;
+    }
+    for(auto level = highestLevel; level > 0; --level)
+    {
+        cascade(level);
+    }
+
+    auto& slot = slots_[0][tick_ & (WHEELSLOTS - 1)];
+    auto expired = std::vector<uint32_t>{};
+    expired.reserve(std::size(slot));
+    for(const auto& timer : slot)
+    {
+        expired.push_back(timer.timerId);
+    }
+    slot.clear();
+    tick_++;
+    return expired;
+}
+
+uint64_t TimerWheel::getTick() const
+{
+    return tick_;
+}
+
+void TimerWheel::cascade(const std::size_t level)
+{
+    auto timers = std::vector<Timer>{};
+    timers.swap(slots_[level][(tick_ >> (SLOTBITS * level)) & (WHEELSLOTS - 1)]);
+    for(const auto& timer : timers)
+    {
+        schedule(timer.tick, timer.timerId);
+    }
+}
+
+} // trafficsimulation::model
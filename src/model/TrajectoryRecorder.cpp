@@ -0,0 +1,82 @@
+#include "../include/model/TrajectoryRecorder.hpp"
+
+#include <algorithm>
+
+#include "../include/common/BinaryStream.hpp"
+
+namespace trafficsimulation::model
+{
+
+TrajectoryRecorder::TrajectoryRecorder()
+    : file_{}
+    , frameOffsets_{}
+    , maxDriverCount_{0}
+    , maxPedestrianCount_{0}
+{
+}
+
+TrajectoryRecorder::~TrajectoryRecorder()
+{
+    close();
+}
+
+std::optional<std::string> TrajectoryRecorder::open(const std::string& filePath,
+    const common::Layout& layout)
+{
+    close();
+    file_.open(filePath, std::ios::binary | std::ios::trunc);
+    if(!file_.is_open())
+    {
+        return "Could not open file " + filePath + " for recording";
+    }
+    frameOffsets_.clear();
+    maxDriverCount_ = 0;
+    maxPedestrianCount_ = 0;
+
+    common::writeValue(file_, TRAJECTORYFILEMAGIC);
+    common::writeValue(file_, TRAJECTORYFILEVERSION);
+    common::writeVector(file_, layout.junctions);
+    common::writeVector(file_, layout.roads);
+    common::writeVector(file_, layout.pavements);
+    return {};
+}
+
+void TrajectoryRecorder::record(const common::Frame& frame)
+{
+    if(!file_.is_open())
+    {
+        return;
+    }
+    frameOffsets_.push_back(static_cast<uint64_t>(file_.tellp()));
+    common::writeValue(file_, frame.tick);
+    common::writeVector(file_, frame.drivers);
+    common::writeVector(file_, frame.driverIds);
+    common::writeVector(file_, frame.pedestrians);
+    common::writeVector(file_, frame.pedestrianIds);
+    maxDriverCount_ = std::max(maxDriverCount_, static_cast<uint32_t>(std::size(frame.drivers)));
+    maxPedestrianCount_ = std::max(maxPedestrianCount_,
+        static_cast<uint32_t>(std::size(frame.pedestrians)));
+}
+
+void TrajectoryRecorder::close()
+{
+    if(!file_.is_open())
+    {
+        return;
+    }
+    const auto indexOffset = static_cast<uint64_t>(file_.tellp());
+    common::writeVector(file_, frameOffsets_);
+    common::writeValue(file_, maxDriverCount_);
+    common::writeValue(file_, maxPedestrianCount_);
+    common::writeValue(file_, indexOffset);
+    common::writeValue(file_, TRAJECTORYFILEMAGIC);
+    file_.close();
+    frameOffsets_.clear();
+}
+
+bool TrajectoryRecorder::isOpen() const
+{
+    return file_.is_open();
+}
+
+} // trafficsimulation::model
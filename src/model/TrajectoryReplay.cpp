@@ -0,0 +1,339 @@
+#include "../include/model/TrajectoryReplay.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "../include/common/BinaryStream.hpp"
+#include "../include/interface/PointPainter.hpp"
+#include "../include/model/TrajectoryRecorder.hpp"
+
+namespace trafficsimulation::model
+{
+
+/* index offset and magic at the end of file */
+constexpr auto TRAJECTORYFILEFOOTERSIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+namespace
+{
+
+void paintObjects(const std::vector<common::Point>& points, const std::vector<uint32_t>& ids,
+    std::unordered_map<uint32_t, interface::PointPainter*>& painters,
+    std::vector<interface::PointPainter*>& freePainters)
+{
+    /* objects keep their painters, painters of objects missing in frame go to new objects */
+    auto shownPainters = std::unordered_map<uint32_t, interface::PointPainter*>{};
+    shownPainters.reserve(std::size(ids));
+    for(const auto id : ids)
+    {
+        const auto painter = painters.find(id);
+        if(painter != std::end(painters))
+        {
+            shownPainters.insert(*painter);
+            painters.erase(painter);
+        }
+    }
+    for(const auto& painter : painters)
+    {
+        painter.second->setPoint(common::HIDDENPOINT);
+        painter.second->paint();
+        freePainters.push_back(painter.second);
+    }
+
+    for(auto iterator = std::size_t{0}; iterator < std::size(ids); ++iterator)
+    {
+        auto painter = shownPainters.find(ids[iterator]);
+        if(painter == std::end(shownPainters))
+        {
+            if(freePainters.empty())
+            {
+                continue;
+            }
+            painter = shownPainters.emplace(ids[iterator], freePainters.back()).first;
+            freePainters.pop_back();
+        }
+        painter->second->setPoint(points[iterator]);
+        painter->second->paint();
+    }
+    painters = std::move(shownPainters);
+}
+
+}
+
+TrajectoryReplay::TrajectoryReplay()
+    : file_{}
+    , layout_{}
+    , frameOffsets_{}
+    , firstFrameOffset_{0}
+    , maxDriverCount_{0}
+    , maxPedestrianCount_{0}
+    , driverPainters_{}
+    , pedestrianPainters_{}
+    , freeDriverPainters_{}
+    , freePedestrianPainters_{}
+    , playhead_{0}
+    , speed_{1}
+    , replayTimer_{nullptr}
+{
+    auto timer = new QTimer();
+    connect(timer, &QTimer::timeout, this, &TrajectoryReplay::advance);
+    replayTimer_ = std::unique_ptr<QTimer>(timer);
+}
+
+TrajectoryReplay::~TrajectoryReplay() = default;
+
+std::optional<std::string> TrajectoryReplay::load(const std::string& filePath)
+{
+    pause();
+    frameOffsets_.clear();
+    file_.close();
+    file_.open(filePath, std::ios::binary);
+    if(!file_.is_open())
+    {
+        return "Could not open file " + filePath;
+    }
+
+    auto magic = uint32_t{0};
+    auto version = uint32_t{0};
+    if(!common::readValue(file_, magic) || magic != TRAJECTORYFILEMAGIC
+        || !common::readValue(file_, version) || version != TRAJECTORYFILEVERSION)
+    {
+        return "File " + filePath + " is not a trajectory recording";
+    }
+    if(!common::readVector(file_, layout_.junctions) || !common::readVector(file_, layout_.roads)
+        || !common::readVector(file_, layout_.pavements))
+    {
+        return "Layout of recording " + filePath + " is corrupted";
+    }
+    firstFrameOffset_ = static_cast<uint64_t>(file_.tellg());
+
+    if(!readIndex())
+    {
+        rebuildIndex();
+    }
+    if(std::size(frameOffsets_) == 0)
+    {
+        return "Recording " + filePath + " has no frames";
+    }
+    playhead_ = 0;
+    return {};
+}
+
+const common::Layout& TrajectoryReplay::getLayout() const
+{
+    return layout_;
+}
+
+uint64_t TrajectoryReplay::getFrameCount() const
+{
+    return std::size(frameOffsets_);
+}
+
+uint64_t TrajectoryReplay::getCurrentFrame() const
+{
+    return static_cast<uint64_t>(playhead_);
+}
+
+uint32_t TrajectoryReplay::getMaxDriverCount() const
+{
+    return maxDriverCount_;
+}
+
+uint32_t TrajectoryReplay::getMaxPedestrianCount() const
+{
+    return maxPedestrianCount_;
+}
+
+void TrajectoryReplay::setPainters(const std::vector<interface::PointPainter*> driverPainters,
+    const std::vector<interface::PointPainter*> pedestrianPainters)
+{
+    driverPainters_.clear();
+    pedestrianPainters_.clear();
+    freeDriverPainters_ = driverPainters;
+    freePedestrianPainters_ = pedestrianPainters;
+}
+
+void TrajectoryReplay::play(const uint32_t timeout)
+{
+    if(std::size(frameOffsets_) == 0 || replayTimer_->isActive())
+    {
+        return;
+    }
+    if(getCurrentFrame() + 1 >= getFrameCount())
+    {
+        playhead_ = 0;
+    }
+    replayTimer_->start(timeout);
+}
+
+void TrajectoryReplay::pause()
+{
+    if(replayTimer_->isActive())
+    {
+        replayTimer_->stop();
+    }
+}
+
+bool TrajectoryReplay::isPlaying() const
+{
+    return replayTimer_->isActive();
+}
+
+void TrajectoryReplay::seek(const uint64_t frame)
+{
+    if(std::size(frameOffsets_) == 0)
+    {
+        return;
+    }
+    playhead_ = static_cast<double>(std::min(frame, getFrameCount() - 1));
+
+    const auto currentFrame = readFrame(getCurrentFrame());
+    if(currentFrame.has_value())
+    {
+        paintFrame(currentFrame.value());
+    }
+    emit frameChanged(getCurrentFrame());
+}
+
+void TrajectoryReplay::setSpeed(const float speed)
+{
+    speed_ = std::max(speed, float{0});
+}
+
+void TrajectoryReplay::advance()
+{
+    const auto lastFrame = static_cast<double>(getFrameCount() - 1);
+    if(playhead_ + speed_ >= lastFrame)
+    {
+        pause();
+        seek(getFrameCount() - 1);
+        return;
+    }
+    const auto previousFrame = getCurrentFrame();
+    playhead_ += speed_;
+    if(getCurrentFrame() == previousFrame)
+    {
+        return;
+    }
+    seek(getCurrentFrame());
+}
+
+std::optional<common::Frame> TrajectoryReplay::readFrame(const uint64_t frame)
+{
+    if(frame >= getFrameCount())
+    {
+        return {};
+    }
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(frameOffsets_[frame]));
+
+    auto result = common::Frame{};
+    if(!common::readValue(file_, result.tick) || !common::readVector(file_, result.drivers)
+        || !common::readVector(file_, result.driverIds)
+        || !common::readVector(file_, result.pedestrians)
+        || !common::readVector(file_, result.pedestrianIds)
+        || std::size(result.driverIds) != std::size(result.drivers)
+        || std::size(result.pedestrianIds) != std::size(result.pedestrians))
+    {
+        return {};
+    }
+    return result;
+}
+
+bool TrajectoryReplay::readIndex()
+{
+    file_.clear();
+    file_.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(file_.tellg());
+    if(fileSize < firstFrameOffset_ + TRAJECTORYFILEFOOTERSIZE)
+    {
+        return false;
+    }
+
+    auto indexOffset = uint64_t{0};
+    auto magic = uint32_t{0};
+    file_.seekg(static_cast<std::streamoff>(fileSize - TRAJECTORYFILEFOOTERSIZE));
+    if(!common::readValue(file_, indexOffset) || !common::readValue(file_, magic)
+        || magic != TRAJECTORYFILEMAGIC || indexOffset < firstFrameOffset_
+        || indexOffset >= fileSize)
+    {
+        return false;
+    }
+
+    file_.seekg(static_cast<std::streamoff>(indexOffset));
+    if(!common::readVector(file_, frameOffsets_) || !common::readValue(file_, maxDriverCount_)
+        || !common::readValue(file_, maxPedestrianCount_))
+    {
+        frameOffsets_.clear();
+        return false;
+    }
+    /* frames lie between layout and index in order they were recorded */
+    for(auto iterator = std::size_t{0}; iterator < std::size(frameOffsets_); ++iterator)
+    {
+        if(frameOffsets_[iterator] < firstFrameOffset_ || frameOffsets_[iterator] >= indexOffset
+            || (iterator != 0 && frameOffsets_[iterator] <= frameOffsets_[iterator - 1]))
+        {
+            frameOffsets_.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void TrajectoryReplay::rebuildIndex()
+{
+    frameOffsets_.clear();
+    maxDriverCount_ = 0;
+    maxPedestrianCount_ = 0;
+
+    file_.clear();
+    file_.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(file_.tellg());
+
+    /* last frame may be cut in half if recording was interrupted, it is skipped */
+    auto offset = firstFrameOffset_;
+    /* moves offset past vector of elements of given size, returns its size */
+    const auto skipVector = [this, fileSize, &offset](const std::size_t elementSize)
+        -> std::optional<uint32_t>
+        {
+            auto size = uint32_t{0};
+            file_.seekg(static_cast<std::streamoff>(offset));
+            if(offset + sizeof(uint32_t) > fileSize || !common::readValue(file_, size))
+            {
+                return {};
+            }
+            const auto nextOffset = offset + sizeof(uint32_t) + size * elementSize;
+            if(nextOffset > fileSize)
+            {
+                return {};
+            }
+            offset = nextOffset;
+            return size;
+        };
+    while(offset + sizeof(uint64_t) <= fileSize)
+    {
+        const auto frameOffset = offset;
+        offset += sizeof(uint64_t);
+        const auto driverCount = skipVector(sizeof(common::Point));
+        const auto driverIdCount = skipVector(sizeof(uint32_t));
+        const auto pedestrianCount = skipVector(sizeof(common::Point));
+        const auto pedestrianIdCount = skipVector(sizeof(uint32_t));
+        if(!driverCount.has_value() || !driverIdCount.has_value()
+            || !pedestrianCount.has_value() || !pedestrianIdCount.has_value())
+        {
+            break;
+        }
+
+        frameOffsets_.push_back(frameOffset);
+        maxDriverCount_ = std::max(maxDriverCount_, driverCount.value());
+        maxPedestrianCount_ = std::max(maxPedestrianCount_, pedestrianCount.value());
+    }
+}
+
+void TrajectoryReplay::paintFrame(const common::Frame& frame)
+{
+    paintObjects(frame.drivers, frame.driverIds, driverPainters_, freeDriverPainters_);
+    paintObjects(frame.pedestrians, frame.pedestrianIds, pedestrianPainters_,
+        freePedestrianPainters_);
+}
+
+} // trafficsimulation::model
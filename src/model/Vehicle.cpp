@@ -10,13 +10,58 @@ Vehicle::Vehicle(const uint32_t maxAcceleration, const uint32_t maxDeceleration)
     , maxDeceleration_{maxDeceleration}
     , speed_{0}
     , distanceTravelled_{0}
+    , asleep_{false}
+    , lane_{0}
     , vehicleAhead_{nullptr}
     , vehicleBehind_{nullptr}
+    , queueIndex_{0}
 {
 }
 
 Vehicle::~Vehicle() = default;
 
+void Vehicle::reset(const uint32_t maxAcceleration, const uint32_t maxDeceleration)
+{
+    maxAcceleration_ = maxAcceleration;
+    maxDeceleration_ = maxDeceleration;
+    speed_ = 0;
+    distanceTravelled_ = 0;
+    asleep_ = false;
+    lane_ = 0;
+    vehicleAhead_ = nullptr;
+    vehicleBehind_ = nullptr;
+}
+
+uint32_t Vehicle::getDistanceTravelled() const
+{
+    return distanceTravelled_;
+}
+
+bool Vehicle::isAsleep() const
+{
+    return asleep_;
+}
+
+uint32_t Vehicle::getLane() const
+{
+    return lane_;
+}
+
+void Vehicle::setLane(const uint32_t lane)
+{
+    lane_ = lane;
+}
+
+Vehicle* Vehicle::getVehicleAhead() const
+{
+    return vehicleAhead_;
+}
+
+Vehicle* Vehicle::getVehicleBehind() const
+{
+    return vehicleBehind_;
+}
+
 void Vehicle::setVehicleAhead(Vehicle* const vehicleAhead)
 {
     vehicleAhead_ = vehicleAhead;
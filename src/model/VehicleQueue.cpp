@@ -0,0 +1,254 @@
+#include "../include/model/VehicleQueue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../include/model/Vehicle.hpp"
+
+namespace trafficsimulation::model
+{
+
+constexpr auto INITIALCAPACITY = std::size_t{8};
+
+VehicleQueue::VehicleQueue()
+    : vehicles_{}
+    , first_{0}
+    , size_{0}
+    , vehicleCount_{0}
+{
+}
+
+VehicleQueue::~VehicleQueue() = default;
+
+bool VehicleQueue::isEmpty() const
+{
+    return vehicleCount_ == 0;
+}
+
+std::size_t VehicleQueue::getSize() const
+{
+    return vehicleCount_;
+}
+
+Vehicle* VehicleQueue::getFirst() const
+{
+    /* first and last place are never holes */
+    return size_ == 0 ? nullptr : vehicles_[first_];
+}
+
+Vehicle* VehicleQueue::getLast() const
+{
+    return size_ == 0 ? nullptr : vehicles_[getIndex(size_ - 1)];
+}
+
+Vehicle* VehicleQueue::findPlace(const uint32_t distanceTravelled) const
+{
+    /* hole is treated as first vehicle behind it, so places stay sorted */
+    auto begin = std::size_t{0};
+    auto end = size_;
+    while(begin < end)
+    {
+        const auto middle = begin + (end - begin) / 2;
+        const auto vehicle = findVehicle(middle);
+        if(vehicles_[getIndex(vehicle)]->getDistanceTravelled() >= distanceTravelled)
+        {
+            begin = vehicle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    return begin == size_ ? nullptr : vehicles_[getIndex(findVehicle(begin))];
+}
+
+void VehicleQueue::reserve(const std::size_t count)
+{
+    auto capacity = std::max(std::size(vehicles_), INITIALCAPACITY);
+    while(capacity < size_ + count)
+    {
+        capacity *= 2;
+    }
+    if(capacity != std::size(vehicles_))
+    {
+        grow(capacity);
+    }
+}
+
+void VehicleQueue::pushBack(Vehicle* const vehicle)
+{
+    if(size_ == std::size(vehicles_))
+    {
+        reserve();
+    }
+    setVehicle(size_, vehicle);
+    size_++;
+    vehicleCount_++;
+}
+
+void VehicleQueue::popFront()
+{
+    vehicleCount_--;
+    do
+    {
+        first_ = getIndex(1);
+        size_--;
+    }
+    while(size_ != 0 && vehicles_[first_] == nullptr);
+}
+
+void VehicleQueue::insert(Vehicle* const vehicleBehind, Vehicle* const vehicle)
+{
+    if(vehicleBehind == nullptr)
+    {
+        pushBack(vehicle);
+        return;
+    }
+    auto position = getPosition(vehicleBehind);
+    if(position != 0 && vehicles_[getIndex(position - 1)] == nullptr)
+    {
+        setVehicle(position - 1, vehicle);
+        vehicleCount_++;
+        return;
+    }
+    if(size_ == std::size(vehicles_))
+    {
+        reserve();
+        position = getPosition(vehicleBehind);
+    }
+    if(position == 0)
+    {
+        first_ = getIndex(std::size(vehicles_) - 1);
+        size_++;
+        setVehicle(0, vehicle);
+        vehicleCount_++;
+        return;
+    }
+
+    auto hole = position + 1;
+    while(hole < size_ && vehicles_[getIndex(hole)] != nullptr)
+    {
+        ++hole;
+    }
+    if(hole == size_)
+    {
+        size_++;
+    }
+    for(auto iterator = hole; iterator > position; --iterator)
+    {
+        setVehicle(iterator, vehicles_[getIndex(iterator - 1)]);
+    }
+    setVehicle(position, vehicle);
+    vehicleCount_++;
+}
+
+bool VehicleQueue::erase(Vehicle* const vehicle)
+{
+    if(size_ != 0 && vehicles_[first_] == vehicle)
+    {
+        popFront();
+        return true;
+    }
+    const auto position = getPosition(vehicle);
+    if(position == size_)
+    {
+        return false;
+    }
+    vehicles_[getIndex(position)] = nullptr;
+    vehicleCount_--;
+    while(vehicles_[getIndex(size_ - 1)] == nullptr)
+    {
+        size_--;
+    }
+    if(size_ - vehicleCount_ > vehicleCount_)
+    {
+        compact();
+    }
+    return true;
+}
+
+void VehicleQueue::clear()
+{
+    first_ = 0;
+    size_ = 0;
+    vehicleCount_ = 0;
+}
+
+std::size_t VehicleQueue::getIndex(const std::size_t position) const
+{
+    /* capacity is power of two */
+    return (first_ + position) & (std::size(vehicles_) - 1);
+}
+
+std::size_t VehicleQueue::getPosition(const Vehicle* const vehicle) const
+{
+    const auto index = vehicle->queueIndex_;
+    if(index >= std::size(vehicles_) || vehicles_[index] != vehicle)
+    {
+        return size_;
+    }
+    const auto position = (index - first_) & (std::size(vehicles_) - 1);
+    return position < size_ ? position : size_;
+}
+
+std::size_t VehicleQueue::findVehicle(std::size_t position) const
+{
+    while(position < size_ && vehicles_[getIndex(position)] == nullptr)
+    {
+        ++position;
+    }
+    return position;
+}
+
+void VehicleQueue::setVehicle(const std::size_t position, Vehicle* const vehicle)
+{
+    const auto index = getIndex(position);
+    vehicles_[index] = vehicle;
+    vehicle->queueIndex_ = index;
+}
+
+void VehicleQueue::reserve()
+{
+    if(vehicleCount_ * 2 >= std::size(vehicles_))
+    {
+        grow(std::max(std::size(vehicles_) * 2, INITIALCAPACITY));
+        return;
+    }
+    compact();
+}
+
+void VehicleQueue::compact()
+{
+    auto size = std::size_t{0};
+    for(auto position = std::size_t{0}; position < size_; ++position)
+    {
+        const auto vehicle = vehicles_[getIndex(position)];
+        if(vehicle != nullptr)
+        {
+            setVehicle(size, vehicle);
+            size++;
+        }
+    }
+    size_ = size;
+}
+
+void VehicleQueue::grow(const std::size_t capacity)
+{
+    auto vehicles = std::vector<Vehicle*>(capacity);
+    auto size = std::size_t{0};
+    for(auto position = std::size_t{0}; position < size_; ++position)
+    {
+        const auto vehicle = vehicles_[getIndex(position)];
+        if(vehicle != nullptr)
+        {
+            vehicles[size] = vehicle;
+            vehicle->queueIndex_ = size;
+            size++;
+        }
+    }
+    vehicles_ = std::move(vehicles);
+    first_ = 0;
+    size_ = size;
+}
+
+} // trafficsimulation::model
@@ -0,0 +1,84 @@
+#include "../include/view/DensityLayer.hpp"
+
+#include <algorithm>
+
+#include <QColor>
+#include <QPainter>
+#include <QPen>
+#include <QTransform>
+
+#include "../include/view/PointPainters.hpp"
+
+namespace trafficsimulation::view
+{
+
+constexpr auto DENSITYZVALUE = qreal{1};
+constexpr auto DENSITYPENWIDTH = uint32_t{7};
+// space around scene for lines of roads that reach its edge
+constexpr auto BOUNDINGRECTMARGIN = qreal{25};
+
+namespace
+{
+
+QColor occupancyColor(const float occupancy)
+{
+    const auto load = std::clamp(occupancy, 0.0f, 1.0f);
+    return QColor{static_cast<int>(255 * std::min(1.0f, 2 * load)),
+        static_cast<int>(255 * std::min(1.0f, 2 * (1 - load))), 0};
+}
+
+}
+
+DensityLayer::DensityLayer(const QRectF sceneRect)
+    : interface::DensityPainter{}
+    , QGraphicsItem{}
+    , sceneRect_{sceneRect}
+    , roadLoads_{}
+    , paintedScale_{1}
+{
+    setZValue(DENSITYZVALUE);
+}
+
+DensityLayer::~DensityLayer() = default;
+
+void DensityLayer::setRoadLoads(const std::vector<common::RoadLoad>& roadLoads)
+{
+    roadLoads_ = roadLoads;
+}
+
+void DensityLayer::paint()
+{
+    if(paintedScale_ < AGENTSMINSCALE)
+    {
+        update();
+    }
+}
+
+void DensityLayer::setSceneRect(const QRectF sceneRect)
+{
+    prepareGeometryChange();
+    sceneRect_ = sceneRect;
+}
+
+void DensityLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    paintedScale_ = painter->worldTransform().m11();
+    if(paintedScale_ >= AGENTSMINSCALE)
+    {
+        return;
+    }
+    for(const auto& roadLoad : roadLoads_)
+    {
+        painter->setPen(QPen{occupancyColor(roadLoad.occupancy), DENSITYPENWIDTH, Qt::SolidLine});
+        painter->drawLine(roadLoad.line.startPoint.x, roadLoad.line.startPoint.y,
+            roadLoad.line.endPoint.x, roadLoad.line.endPoint.y);
+    }
+}
+
+QRectF DensityLayer::boundingRect() const
+{
+    return sceneRect_.adjusted(-BOUNDINGRECTMARGIN, -BOUNDINGRECTMARGIN,
+        BOUNDINGRECTMARGIN, BOUNDINGRECTMARGIN);
+}
+
+} // trafficsimulation::view
@@ -0,0 +1,161 @@
+#include "../include/view/FrameExporter.hpp"
+
+#include <filesystem>
+
+#include <QChar>
+#include <QString>
+
+namespace trafficsimulation::view
+{
+
+constexpr auto EXPORTQUEUESIZE = std::size_t{8};
+constexpr auto PNGFILENAMEFORMAT = "frame_%1.png";
+constexpr auto PNGFILENAMEDIGITS = 6;
+
+FrameExporter::FrameExporter(const ExportFormat format)
+    : format_{format}
+    , outputPath_{}
+    , videoFile_{}
+    , queue_{}
+    , frameCount_{0}
+    , closing_{false}
+    , error_{}
+    , mutex_{}
+    , queueChanged_{}
+    , encoder_{}
+{
+}
+
+FrameExporter::~FrameExporter()
+{
+    close();
+}
+
+std::optional<std::string> FrameExporter::open(const std::string& outputPath)
+{
+    close();
+    if(format_ == ExportFormat::PngSequence)
+    {
+        auto errorCode = std::error_code{};
+        std::filesystem::create_directories(outputPath, errorCode);
+        if(errorCode)
+        {
+            return "Could not create directory " + outputPath + ": " + errorCode.message();
+        }
+    }
+    else
+    {
+        videoFile_.open(outputPath, std::ios::binary | std::ios::trunc);
+        if(!videoFile_.is_open())
+        {
+            return "Could not open file " + outputPath + " for export";
+        }
+    }
+    outputPath_ = outputPath;
+    frameCount_ = 0;
+    closing_ = false;
+    error_ = {};
+    encoder_ = std::thread{&FrameExporter::runEncoder, this};
+    return {};
+}
+
+std::optional<std::string> FrameExporter::write(const QImage& image)
+{
+    // without encoder thread nothing would empty full queue
+    if(!encoder_.joinable())
+    {
+        return "Exporter is not open";
+    }
+    auto lock = std::unique_lock{mutex_};
+    if(error_.has_value())
+    {
+        return error_;
+    }
+    queueChanged_.wait(lock, [this](){ return std::size(queue_) < EXPORTQUEUESIZE; });
+    queue_.push_back(image);
+    queueChanged_.notify_all();
+    return {};
+}
+
+std::optional<std::string> FrameExporter::close()
+{
+    if(!encoder_.joinable())
+    {
+        return {};
+    }
+    {
+        auto lock = std::lock_guard{mutex_};
+        closing_ = true;
+    }
+    queueChanged_.notify_all();
+    encoder_.join();
+    videoFile_.close();
+    return error_;
+}
+
+uint64_t FrameExporter::getFrameCount()
+{
+    auto lock = std::lock_guard{mutex_};
+    return frameCount_;
+}
+
+void FrameExporter::runEncoder()
+{
+    auto lock = std::unique_lock{mutex_};
+    while(true)
+    {
+        queueChanged_.wait(lock, [this](){ return !std::empty(queue_) || closing_; });
+        if(std::empty(queue_))
+        {
+            return;
+        }
+        const auto image = queue_.front();
+        queue_.pop_front();
+        queueChanged_.notify_all();
+        if(error_.has_value())
+        {
+            continue;
+        }
+
+        const auto frame = frameCount_;
+        lock.unlock();
+        auto result = encode(image, frame);
+        lock.lock();
+        if(result.has_value())
+        {
+            error_ = std::move(result);
+            continue;
+        }
+        frameCount_++;
+    }
+}
+
+std::optional<std::string> FrameExporter::encode(const QImage& image, const uint64_t frame)
+{
+    if(format_ == ExportFormat::PngSequence)
+    {
+        const auto fileName = QString{PNGFILENAMEFORMAT}.arg(frame, PNGFILENAMEDIGITS, 10,
+            QChar{'0'});
+        const auto filePath = (std::filesystem::path{outputPath_} / fileName.toStdString()).string();
+        if(!image.save(QString::fromStdString(filePath), "PNG"))
+        {
+            return "Could not write image " + filePath;
+        }
+        return {};
+    }
+
+    // scan lines of QImage are padded to 4 bytes, stream has to be tightly packed
+    const auto rgbImage = image.convertToFormat(QImage::Format_RGB888);
+    const auto lineSize = static_cast<std::streamsize>(rgbImage.width() * 3);
+    for(auto line = 0; line < rgbImage.height(); ++line)
+    {
+        videoFile_.write(reinterpret_cast<const char*>(rgbImage.constScanLine(line)), lineSize);
+    }
+    if(!videoFile_.good())
+    {
+        return "Could not write frame to " + outputPath_;
+    }
+    return {};
+}
+
+} // trafficsimulation::view
@@ -0,0 +1,127 @@
+#include "../include/view/FrameRenderer.hpp"
+
+#include <algorithm>
+
+#include <QBrush>
+#include <QColor>
+#include <QPainter>
+#include <QPen>
+#include <QPointF>
+#include <QRectF>
+
+#include "../include/view/PaintSizes.hpp"
+
+namespace trafficsimulation::view
+{
+
+// space around layout for junctions that lie on its edge
+constexpr auto LAYOUTMARGIN = qreal{25};
+// agents smaller than this number of pixels are drawn without antialiasing, it is not visible
+constexpr auto ANTIALIASEDAGENTMINDIAMETER = qreal{4};
+
+namespace
+{
+
+QRectF calculateLayoutRect(const common::Layout& layout)
+{
+    auto points = layout.junctions;
+    for(const auto& lines : {layout.roads, layout.pavements})
+    {
+        for(const auto& line : lines)
+        {
+            points.push_back(line.startPoint);
+            points.push_back(line.endPoint);
+        }
+    }
+    if(std::empty(points))
+    {
+        return QRectF{0, 0, 1, 1};
+    }
+
+    auto layoutRect = QRectF{QPointF(points.front().x, points.front().y),
+        QPointF(points.front().x, points.front().y)};
+    for(const auto& point : points)
+    {
+        layoutRect = layoutRect.united(QRectF{QPointF(point.x, point.y), QPointF(point.x, point.y)});
+    }
+    return layoutRect.adjusted(-LAYOUTMARGIN, -LAYOUTMARGIN, LAYOUTMARGIN, LAYOUTMARGIN);
+}
+
+void drawAgents(QPainter& painter, const std::vector<common::Point>& agents,
+    const uint32_t diameter)
+{
+    const auto radius = qreal(diameter) / 2;
+    painter.setRenderHint(QPainter::Antialiasing,
+        diameter * painter.transform().m11() >= ANTIALIASEDAGENTMINDIAMETER);
+    for(const auto& agent : agents)
+    {
+        if(agent == common::HIDDENPOINT)
+        {
+            continue;
+        }
+        painter.drawEllipse(QPointF(agent.x, agent.y), radius, radius);
+    }
+}
+
+}
+
+FrameRenderer::FrameRenderer(const common::Layout& layout, const QSize imageSize)
+    : transform_{}
+    , networkImage_{imageSize, QImage::Format_RGB32}
+{
+    const auto layoutRect = calculateLayoutRect(layout);
+    const auto scale = std::min(imageSize.width() / layoutRect.width(),
+        imageSize.height() / layoutRect.height());
+    transform_.translate((imageSize.width() - layoutRect.width() * scale) / 2,
+        (imageSize.height() - layoutRect.height() * scale) / 2);
+    transform_.scale(scale, scale);
+    transform_.translate(-layoutRect.left(), -layoutRect.top());
+
+    renderLayout(layout);
+}
+
+FrameRenderer::~FrameRenderer() = default;
+
+QImage FrameRenderer::render(const common::Frame& frame) const
+{
+    auto image = networkImage_.copy();
+    auto painter = QPainter{&image};
+    painter.setTransform(transform_);
+    painter.setPen(Qt::NoPen);
+
+    painter.setBrush(QBrush{Qt::red});
+    drawAgents(painter, frame.drivers, DRIVERDIAMETER);
+    painter.setBrush(QBrush{Qt::darkMagenta});
+    drawAgents(painter, frame.pedestrians, PEDESTRIANDIAMETER);
+    return image;
+}
+
+void FrameRenderer::renderLayout(const common::Layout& layout)
+{
+    networkImage_.fill(Qt::white);
+    auto painter = QPainter{&networkImage_};
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setTransform(transform_);
+
+    painter.setPen(QPen{Qt::darkGreen, PAVEMENTPENWIDTH, Qt::SolidLine});
+    for(const auto& pavement : layout.pavements)
+    {
+        painter.drawLine(pavement.startPoint.x, pavement.startPoint.y,
+            pavement.endPoint.x, pavement.endPoint.y);
+    }
+    painter.setPen(QPen{Qt::darkGray, ROADPENWIDTH, Qt::SolidLine});
+    for(const auto& road : layout.roads)
+    {
+        painter.drawLine(road.startPoint.x, road.startPoint.y, road.endPoint.x, road.endPoint.y);
+    }
+
+    const auto radius = qreal(JUNCTIONDIAMETER) / 2;
+    painter.setPen(QPen{Qt::darkBlue, 2, Qt::SolidLine});
+    painter.setBrush(QBrush{Qt::darkCyan});
+    for(const auto& junction : layout.junctions)
+    {
+        painter.drawEllipse(QPointF(junction.x, junction.y), radius, radius);
+    }
+}
+
+} // trafficsimulation::view
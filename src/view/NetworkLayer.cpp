@@ -0,0 +1,179 @@
+#include "../include/view/NetworkLayer.hpp"
+
+#include <cmath>
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QTransform>
+
+namespace trafficsimulation::view
+{
+
+constexpr auto NETWORKZVALUE = qreal{0};
+// space around scene for junctions and paths that reach its edge
+constexpr auto BOUNDINGRECTMARGIN = qreal{25};
+// part of exposed rect added at each side of cache, so small moves of view reuse it
+constexpr auto CACHEMARGIN = qreal{0.5};
+
+NetworkPathPainter::NetworkPathPainter(NetworkLayer* const layer,
+    std::unique_ptr<PathPainter> pathPainter)
+    : interface::LinePainter{}
+    , layer_{layer}
+    , pathPainter_{std::move(pathPainter)}
+{
+}
+
+NetworkPathPainter::~NetworkPathPainter() = default;
+
+void NetworkPathPainter::setPoints(const common::Point startPoint, const common::Point endPoint)
+{
+    pathPainter_->setPoints(startPoint, endPoint);
+    layer_->invalidate();
+}
+
+void NetworkPathPainter::paint()
+{
+}
+
+PathPainter* NetworkPathPainter::getPathPainter() const
+{
+    return pathPainter_.get();
+}
+
+NetworkJunctionPainter::NetworkJunctionPainter(NetworkLayer* const layer)
+    : interface::PointPainter{}
+    , layer_{layer}
+    , junctionPainter_{std::make_unique<JunctionPainter>()}
+    , point_{common::HIDDENPOINT}
+    , paintedPoint_{common::HIDDENPOINT}
+{
+}
+
+NetworkJunctionPainter::~NetworkJunctionPainter() = default;
+
+void NetworkJunctionPainter::setPoint(const common::Point point)
+{
+    point_ = point;
+}
+
+void NetworkJunctionPainter::paint()
+{
+    if(point_ == paintedPoint_)
+    {
+        return;
+    }
+    paintedPoint_ = point_;
+    layer_->invalidate();
+}
+
+JunctionPainter* NetworkJunctionPainter::getJunctionPainter() const
+{
+    return junctionPainter_.get();
+}
+
+common::Point NetworkJunctionPainter::getPaintedPoint() const
+{
+    return paintedPoint_;
+}
+
+NetworkLayer::NetworkLayer(const QRectF sceneRect)
+    : QGraphicsItem{}
+    , sceneRect_{sceneRect}
+    , pathPainters_{}
+    , junctionPainters_{}
+    , cache_{}
+    , cacheRect_{}
+    , cacheScale_{0}
+{
+    setZValue(NETWORKZVALUE);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+NetworkLayer::~NetworkLayer() = default;
+
+interface::LinePainter* NetworkLayer::addRoad()
+{
+    pathPainters_.push_back(std::make_unique<NetworkPathPainter>(this,
+        std::make_unique<RoadPainter>()));
+    return pathPainters_.back().get();
+}
+
+interface::LinePainter* NetworkLayer::addPavement()
+{
+    pathPainters_.push_back(std::make_unique<NetworkPathPainter>(this,
+        std::make_unique<PavementPainter>()));
+    return pathPainters_.back().get();
+}
+
+interface::PointPainter* NetworkLayer::addJunction()
+{
+    junctionPainters_.push_back(std::make_unique<NetworkJunctionPainter>(this));
+    return junctionPainters_.back().get();
+}
+
+void NetworkLayer::invalidate()
+{
+    cache_ = QPixmap{};
+    update();
+}
+
+void NetworkLayer::setSceneRect(const QRectF sceneRect)
+{
+    prepareGeometryChange();
+    sceneRect_ = sceneRect;
+    invalidate();
+}
+
+void NetworkLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    const auto scale = painter->worldTransform().m11();
+    const auto exposedRect = option->exposedRect.intersected(boundingRect());
+    if(exposedRect.isEmpty())
+    {
+        return;
+    }
+    if(cache_.isNull() || scale != cacheScale_ || !cacheRect_.contains(exposedRect))
+    {
+        renderCache(scale, exposedRect);
+    }
+    painter->drawPixmap(cacheRect_, cache_, QRectF(0, 0, cache_.width(), cache_.height()));
+}
+
+QRectF NetworkLayer::boundingRect() const
+{
+    return sceneRect_.adjusted(-BOUNDINGRECTMARGIN, -BOUNDINGRECTMARGIN,
+        BOUNDINGRECTMARGIN, BOUNDINGRECTMARGIN);
+}
+
+void NetworkLayer::renderCache(const qreal scale, const QRectF exposedRect)
+{
+    const auto marginX = exposedRect.width() * CACHEMARGIN;
+    const auto marginY = exposedRect.height() * CACHEMARGIN;
+    const auto rect = exposedRect.adjusted(-marginX, -marginY, marginX, marginY)
+        .intersected(boundingRect());
+    cache_ = QPixmap(static_cast<int>(std::ceil(rect.width() * scale)),
+        static_cast<int>(std::ceil(rect.height() * scale)));
+    cache_.fill(Qt::transparent);
+    cacheRect_ = QRectF(rect.left(), rect.top(), cache_.width() / scale, cache_.height() / scale);
+    cacheScale_ = scale;
+
+    auto painter = QPainter{&cache_};
+    painter.scale(scale, scale);
+    painter.translate(-rect.left(), -rect.top());
+    for(const auto& pathPainter : pathPainters_)
+    {
+        static_cast<QGraphicsItem*>(pathPainter->getPathPainter())->paint(&painter, nullptr, nullptr);
+    }
+    for(const auto& junctionPainter : junctionPainters_)
+    {
+        const auto point = junctionPainter->getPaintedPoint();
+        painter.save();
+        painter.translate(point.x, point.y);
+        static_cast<QGraphicsItem*>(junctionPainter->getJunctionPainter())->paint(&painter,
+            nullptr, nullptr);
+        painter.restore();
+    }
+    painter.end();
+}
+
+} // trafficsimulation::view
@@ -1,26 +1,23 @@
 #include "../include/view/PathPainters.hpp"
 
-#include <cstdlib>
+#include <algorithm>
 
 #include <QBrush>
-#include <QGraphicsScene>
 #include <QPainter>
 
-#include <iostream>
+#include "../include/view/PaintSizes.hpp"
 
 namespace trafficsimulation::view
 {
 
-constexpr auto SCENEWIDTH = uint32_t{1300};
-constexpr auto SCENEHEIGHT = uint32_t{820};
-
 constexpr auto PATHZVALUE = qreal{0};
-constexpr auto PAVEMENTPENWIDTH = uint32_t{3};
-constexpr auto ROADPENWIDTH = uint32_t{5};
+// space around line for its caps and antialiasing
+constexpr auto BOUNDINGRECTMARGIN = qreal{2};
 
-PathPainter::PathPainter()
-    : startPoint_{common::Point{-10, -10}}
-    , endPoint_{common::Point{-10, -10}}
+PathPainter::PathPainter(const uint32_t penWidth)
+    : penWidth_{penWidth}
+    , startPoint_{common::HIDDENPOINT}
+    , endPoint_{common::HIDDENPOINT}
 {
     setZValue(PATHZVALUE);
 }
@@ -29,22 +26,28 @@ PathPainter::~PathPainter() = default;
 
 void PathPainter::setPoints(const common::Point startPoint, const common::Point endPoint)
 {
+    prepareGeometryChange();
     startPoint_ = startPoint;
     endPoint_ = endPoint;
 }
 
 void PathPainter::paint()
 {
-    scene()->update();
 }
 
 QRectF PathPainter::boundingRect() const
 {
-    return QRect(0, 0, SCENEWIDTH, SCENEHEIGHT);
+    const auto margin = qreal(penWidth_) / 2 + BOUNDINGRECTMARGIN;
+    const auto left = std::min(startPoint_.x, endPoint_.x);
+    const auto top = std::min(startPoint_.y, endPoint_.y);
+    const auto right = std::max(startPoint_.x, endPoint_.x);
+    const auto bottom = std::max(startPoint_.y, endPoint_.y);
+    return QRectF(left - margin, top - margin, right - left + 2 * margin,
+        bottom - top + 2 * margin);
 }
 
 PavementPainter::PavementPainter()
-    : PathPainter{}
+    : PathPainter{PAVEMENTPENWIDTH}
 {
 }
 
@@ -57,7 +60,7 @@ void PavementPainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
 }
 
 RoadPainter::RoadPainter()
-    : PathPainter{}
+    : PathPainter{ROADPENWIDTH}
 {
 }
 
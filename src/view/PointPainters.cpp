@@ -1,34 +1,34 @@
 #include "../include/view/PointPainters.hpp"
 
-#include <cstdlib>
-
 #include <QBrush>
-#include <QGraphicsScene>
 #include <QPainter>
+#include <QPointF>
+
+#include "../include/common/RandomGenerator.hpp"
+#include "../include/view/PaintSizes.hpp"
 
 namespace trafficsimulation::view
 {
 
-constexpr auto SCENEWIDTH = uint32_t{1300};
-constexpr auto SCENEHEIGHT = uint32_t{820};
-
 constexpr auto JUNCTIONZVALUE = qreal{2};
 constexpr auto DRIVERZVALUE = qreal{3};
 constexpr auto PEDESTRIANZVALUE = qreal{3};
-constexpr auto JUNCTIONDIAMETER = uint32_t{40};
-constexpr auto DRIVERDIAMETER = uint32_t{10};
-constexpr auto PEDESTRIANDIAMETER = uint32_t{7};
+// space around circle for its outline and antialiasing
+constexpr auto BOUNDINGRECTMARGIN = qreal{2};
+constexpr auto COLORSEED = uint64_t{0x436F6C6F72}; /* "Color" */
 
 namespace
 {
 
 QColor randomColor()
 {
-    auto highValue = std::rand() % 66 + 190;
-    auto lowValue = std::rand() % 90;
-    auto midValue = std::rand() % (highValue - lowValue) + lowValue;
+    static auto random = common::RandomGenerator{COLORSEED, 0};
+
+    auto highValue = static_cast<int>(random.nextInRange(190, 255));
+    auto lowValue = static_cast<int>(random.nextInRange(0, 89));
+    auto midValue = static_cast<int>(random.nextInRange(lowValue, highValue - 1));
 
-    auto distribution = std::rand() % 6;
+    auto distribution = random.next() % 6;
 
     switch (distribution) {
         case 0:
@@ -50,11 +50,13 @@ QColor randomColor()
 
 }
 
-PointPainter::PointPainter()
+PointPainter::PointPainter(const uint32_t diameter)
     : interface::PointPainter{}
     , QGraphicsItem{}
-    , point_{common::Point{-10, -10}}
+    , point_{common::HIDDENPOINT}
+    , diameter_{diameter}
 {
+    setPos(point_.x, point_.y);
 }
 
 PointPainter::~PointPainter() = default;
@@ -66,16 +68,23 @@ void PointPainter::setPoint(const common::Point point)
 
 void PointPainter::paint()
 {
-    update();
+    setPos(point_.x, point_.y);
 }
 
 QRectF PointPainter::boundingRect() const
 {
-    return QRect(0, 0, SCENEWIDTH, SCENEHEIGHT);
+    const auto radius = qreal(diameter_) / 2 + BOUNDINGRECTMARGIN;
+    return QRectF(-radius, -radius, 2 * radius, 2 * radius);
+}
+
+void PointPainter::paintCircle(QPainter *painter) const
+{
+    const auto radius = qreal(diameter_) / 2;
+    painter->drawEllipse(QPointF{0, 0}, radius, radius);
 }
 
 JunctionPainter::JunctionPainter()
-    : PointPainter{}
+    : PointPainter{JUNCTIONDIAMETER}
 {
     setZValue(JUNCTIONZVALUE);
 }
@@ -86,12 +95,11 @@ void JunctionPainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
 {
     painter->setPen(QPen{Qt::darkBlue, 2, Qt::SolidLine});
     painter->setBrush(QBrush{Qt::darkCyan});
-    painter->drawEllipse(point_.x - JUNCTIONDIAMETER/2, point_.y - JUNCTIONDIAMETER/2,
-        JUNCTIONDIAMETER, JUNCTIONDIAMETER);
+    paintCircle(painter);
 }
 
 DriverPainter::DriverPainter()
-    : PointPainter{}
+    : PointPainter{DRIVERDIAMETER}
     , color_{randomColor()}
 {
     setZValue(DRIVERZVALUE);
@@ -103,12 +111,11 @@ void DriverPainter::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
 {
     painter->setPen(QPen{color_, 1, Qt::SolidLine});
     painter->setBrush(QBrush{color_});
-    painter->drawEllipse(point_.x - DRIVERDIAMETER/2, point_.y - DRIVERDIAMETER/2,
-        DRIVERDIAMETER, DRIVERDIAMETER);
+    paintCircle(painter);
 }
 
 PedestrianPainter::PedestrianPainter()
-    : PointPainter{}
+    : PointPainter{PEDESTRIANDIAMETER}
     , color_{randomColor()}
 {
     setZValue(PEDESTRIANZVALUE);
@@ -120,8 +127,137 @@ void PedestrianPainter::paint(QPainter *painter, const QStyleOptionGraphicsItem
 {
     painter->setPen(QPen{color_, 1, Qt::SolidLine});
     painter->setBrush(QBrush{color_});
-    painter->drawEllipse(point_.x - PEDESTRIANDIAMETER/2, point_.y - PEDESTRIANDIAMETER/2,
-        PEDESTRIANDIAMETER, PEDESTRIANDIAMETER);
+    paintCircle(painter);
+}
+
+AgentPainter::AgentPainter(AgentLayer* const layer, const std::size_t agentIndex)
+    : interface::PointPainter{}
+    , layer_{layer}
+    , agentIndex_{agentIndex}
+    , point_{common::HIDDENPOINT}
+{
+}
+
+AgentPainter::~AgentPainter() = default;
+
+void AgentPainter::setPoint(const common::Point point)
+{
+    point_ = point;
+}
+
+void AgentPainter::paint()
+{
+    layer_->moveAgent(agentIndex_, point_);
+}
+
+void AgentPainter::release()
+{
+    point_ = common::HIDDENPOINT;
+    layer_->removeAgent(agentIndex_);
+}
+
+AgentLayer::AgentLayer(const QRectF sceneRect, const uint32_t diameter)
+    : QGraphicsItem{}
+    , sceneRect_{sceneRect}
+    , diameter_{diameter}
+    , positions_{}
+    , colors_{}
+    , painters_{}
+    , freeIndexes_{}
+    , repaintScheduled_{false}
+    , paintedScale_{1}
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+AgentLayer::~AgentLayer() = default;
+
+interface::PointPainter* AgentLayer::addAgent()
+{
+    if(!freeIndexes_.empty())
+    {
+        const auto agentIndex = freeIndexes_.back();
+        freeIndexes_.pop_back();
+        colors_[agentIndex] = randomColor();
+        return painters_[agentIndex].get();
+    }
+    positions_.push_back(QPointF(common::HIDDENPOINT.x, common::HIDDENPOINT.y));
+    colors_.push_back(randomColor());
+    painters_.push_back(std::make_unique<AgentPainter>(this, std::size(painters_)));
+    return painters_.back().get();
 }
 
+void AgentLayer::moveAgent(const std::size_t agentIndex, const common::Point point)
+{
+    const auto position = QPointF(point.x, point.y);
+    if(positions_[agentIndex] == position)
+    {
+        return;
+    }
+    positions_[agentIndex] = position;
+    if(!repaintScheduled_ && paintedScale_ >= AGENTSMINSCALE)
+    {
+        repaintScheduled_ = true;
+        update();
+    }
+}
+
+void AgentLayer::removeAgent(const std::size_t agentIndex)
+{
+    moveAgent(agentIndex, common::HIDDENPOINT);
+    freeIndexes_.push_back(agentIndex);
+}
+
+void AgentLayer::setSceneRect(const QRectF sceneRect)
+{
+    prepareGeometryChange();
+    sceneRect_ = sceneRect;
+}
+
+void AgentLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    repaintScheduled_ = false;
+    paintedScale_ = painter->worldTransform().m11();
+    if(paintedScale_ < AGENTSMINSCALE)
+    {
+        return;
+    }
+
+    // outline of the same color is replaced by half pixel wider circle
+    const auto radius = qreal(diameter_ + 1) / 2;
+    const auto exposedRect = option->exposedRect.adjusted(-radius, -radius, radius, radius);
+    painter->setPen(Qt::NoPen);
+    for(auto agent = std::size_t{0}; agent < std::size(positions_); ++agent)
+    {
+        if(!exposedRect.contains(positions_[agent]))
+        {
+            continue;
+        }
+        painter->setBrush(QBrush{colors_[agent]});
+        painter->drawEllipse(positions_[agent], radius, radius);
+    }
+}
+
+QRectF AgentLayer::boundingRect() const
+{
+    const auto margin = qreal(diameter_) / 2 + BOUNDINGRECTMARGIN;
+    return sceneRect_.adjusted(-margin, -margin, margin, margin);
+}
+
+DriverLayer::DriverLayer(const QRectF sceneRect)
+    : AgentLayer{sceneRect, DRIVERDIAMETER}
+{
+    setZValue(DRIVERZVALUE);
+}
+
+DriverLayer::~DriverLayer() = default;
+
+PedestrianLayer::PedestrianLayer(const QRectF sceneRect)
+    : AgentLayer{sceneRect, PEDESTRIANDIAMETER}
+{
+    setZValue(PEDESTRIANZVALUE);
+}
+
+PedestrianLayer::~PedestrianLayer() = default;
+
 } // trafficsimulation::view
@@ -0,0 +1,36 @@
+#include "../include/view/SnapshotBuffer.hpp"
+
+namespace trafficsimulation::view
+{
+
+SnapshotBuffer::SnapshotBuffer(const QSize imageSize)
+    : interface::SnapshotPainter{}
+    , imageSize_{imageSize}
+    , renderer_{nullptr}
+    , snapshots_{}
+{
+}
+
+SnapshotBuffer::~SnapshotBuffer() = default;
+
+void SnapshotBuffer::setLayout(const common::Layout& layout)
+{
+    renderer_ = std::make_unique<FrameRenderer>(layout, imageSize_);
+    snapshots_.clear();
+}
+
+void SnapshotBuffer::paint(const common::Frame& frame)
+{
+    if(renderer_ == nullptr)
+    {
+        return;
+    }
+    snapshots_.push_back(renderer_->render(frame));
+}
+
+const std::vector<QImage>& SnapshotBuffer::getSnapshots() const
+{
+    return snapshots_;
+}
+
+} // trafficsimulation::view
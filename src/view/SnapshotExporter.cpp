@@ -0,0 +1,40 @@
+#include "../include/view/SnapshotExporter.hpp"
+
+namespace trafficsimulation::view
+{
+
+SnapshotExporter::SnapshotExporter(const QSize imageSize, const ExportFormat format,
+    const std::string& outputPath)
+    : interface::SnapshotPainter{}
+    , imageSize_{imageSize}
+    , outputPath_{outputPath}
+    , renderer_{nullptr}
+    , exporter_{format}
+    , error_{}
+{
+}
+
+SnapshotExporter::~SnapshotExporter() = default;
+
+void SnapshotExporter::setLayout(const common::Layout& layout)
+{
+    renderer_ = std::make_unique<FrameRenderer>(layout, imageSize_);
+    error_ = exporter_.open(outputPath_);
+}
+
+void SnapshotExporter::paint(const common::Frame& frame)
+{
+    if(renderer_ == nullptr || error_.has_value())
+    {
+        return;
+    }
+    error_ = exporter_.write(renderer_->render(frame));
+}
+
+std::optional<std::string> SnapshotExporter::close()
+{
+    const auto result = exporter_.close();
+    return error_.has_value() ? error_ : result;
+}
+
+} // trafficsimulation::view
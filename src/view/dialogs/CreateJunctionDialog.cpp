@@ -5,17 +5,17 @@ namespace trafficsimulation::view::dialogs
 {
 
 CreateJunctionDialog::CreateJunctionDialog(const uint32_t minValue, const uint32_t maxWidth,
-    const uint32_t maxHeight, QWidget *parent)
+    const uint32_t maxHeight, const uint32_t maxValue, QWidget *parent)
     : QDialog{parent}
     , ui_{new Ui::CreateJunctionDialog}
 {
     ui_->setupUi(this);
     ui_->widthSpinBox->setMinimum(minValue);
-    ui_->widthSpinBox->setMaximum(maxWidth);
+    ui_->widthSpinBox->setMaximum(maxValue);
     ui_->widthSpinBox->setValue(std::rand() % (maxWidth - minValue) + minValue);
 
-    ui_->heightSpinBox->setMaximum(minValue);
-    ui_->heightSpinBox->setMaximum(maxHeight);
+    ui_->heightSpinBox->setMinimum(minValue);
+    ui_->heightSpinBox->setMaximum(maxValue);
     ui_->heightSpinBox->setValue(std::rand() % (maxHeight - minValue) + minValue);
 }
 
@@ -26,8 +26,8 @@ CreateJunctionDialog::~CreateJunctionDialog()
 
 common::Point CreateJunctionDialog::getPoint() const
 {
-    return common::Point{static_cast<int16_t>(ui_->widthSpinBox->value()),
-        static_cast<int16_t>(ui_->heightSpinBox->value())};
+    return common::Point{static_cast<int32_t>(ui_->widthSpinBox->value()),
+        static_cast<int32_t>(ui_->heightSpinBox->value())};
 }
 
 } // trafficsimulation::view::dialogs
@@ -75,6 +75,11 @@ uint32_t CreateRoadDialog::getSpeedLimit() const
     return static_cast<uint32_t>(ui_->speedLimitSpinBox->value()) * 10;
 }
 
+uint32_t CreateRoadDialog::getLaneCount() const
+{
+    return static_cast<uint32_t>(ui_->laneCountSpinBox->value());
+}
+
 void CreateRoadDialog::handleStartJunctionChange(int startJunctionId)
 {
     ui_->endJunctionComboBox->clear();